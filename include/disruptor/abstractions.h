@@ -3,6 +3,7 @@
 
 #include <disruptor/utils.h>
 #include <disruptor/sequence.h>
+#include <disruptor/gating_sequences.h>
 
 
 namespace disruptor {
@@ -17,33 +18,45 @@ public:
 
     // Is there available capacity in the buffer for the requested sequence.
     //
-    // @param dependent_sequences to be checked for range.
+    // @param gating_sequences to be checked for range.
     // @return true if the buffer has capacity for the requested sequence.
     virtual bool hasAvailableCapacity(
-        const DependentSequences& dependent_sequences) = 0;
+        const AtomicGatingSequences& gating_sequences) = 0;
 
     // Claim the next sequence in the {@link Sequencer}.
     //
-    // @param dependent_sequences to be checked for range.
+    // @param gating_sequences to be checked for range.
     // @return the index to be used for the publishing.
     virtual int64_t incrementAndGet(
-            const DependentSequences& dependent_sequences) = 0;
+            const AtomicGatingSequences& gating_sequences) = 0;
 
     // Claim the next sequence in the {@link Sequencer}.
     //
     // @param delta to increment by.
-    // @param dependent_sequences to be checked for range.
+    // @param gating_sequences to be checked for range.
     // @return the index to be used for the publishing.
     virtual int64_t incrementAndGet(const int& delta,
-            const DependentSequences& dependent_sequences) = 0;
+            const AtomicGatingSequences& gating_sequences) = 0;
+
+    // Claim the next delta sequences in the {@link Sequencer} only if the
+    // buffer has capacity for all of them, never waiting for consumers.
+    //
+    // @param delta to increment by.
+    // @param gating_sequences to be checked for range.
+    // @param sequence set to the highest claimed sequence on success.
+    // @return true if the sequences were claimed, false if the buffer has
+    // no capacity for them.
+    virtual bool tryIncrementAndGet(const int& delta,
+            const AtomicGatingSequences& gating_sequences,
+            int64_t& sequence) = 0;
 
     // Set the current sequence value for claiming an event in the
     // {@link Sequencer}.
     //
     // @param sequence to be set as the current value.
-    // @param dependent_sequences to be checked for range.
+    // @param gating_sequences to be checked for range.
     virtual void setSequence(const int64_t& sequence,
-            const DependentSequences& dependent_sequences) = 0;
+            const AtomicGatingSequences& gating_sequences) = 0;
 
     // Serialise publishing in sequence.
     //
@@ -53,6 +66,29 @@ public:
     virtual void serialisePublishing(const int64_t& sequence,
                                      Sequence& cursor,
                                      const int64_t& batch_size) = 0;
+
+    // Get the highest sequence that has been published and is safe to read,
+    // scanning from lower_bound up to available_sequence. Strategies that
+    // serialise publishing on the cursor can return available_sequence.
+    //
+    // @param lower_bound the first sequence to check.
+    // @param available_sequence the highest sequence seen on the cursor.
+    // @return the highest contiguous published sequence, which will be
+    // lower_bound - 1 if lower_bound itself is not yet published.
+    virtual int64_t getHighestPublishedSequence(
+            const int64_t& lower_bound,
+            const int64_t& available_sequence) const = 0;
+
+    // Wake the publishers waiting for a free slot, called by the
+    // {@link EventProcessor}s after they moved their sequence.
+    virtual void signalProducers() = 0;
+
+    // Get the number of times publishers found the buffer full and had to
+    // wait for a free slot, or had too many publications pending and had to
+    // wait for the cursor.
+    //
+    // @return the number of producer stalls.
+    virtual int64_t getStallCount() const = 0;
 private:
     IClaimStrategy(const IClaimStrategy&);
     IClaimStrategy& operator= (IClaimStrategy);
@@ -157,6 +193,92 @@ public:
     virtual void onShutdown() = 0;
 };
 
+// Callback through which a {@link ISequenceReportingEventHandler} reports
+// the events it is done with before the end of a batch.
+class ISequenceCallback
+{
+public:
+    virtual ~ISequenceCallback() {};
+
+    // Release the events up to sequence, which publishers can then
+    // overwrite.
+    //
+    // @param sequence of the last event the handler is done with.
+    virtual void set(const int64_t& sequence) = 0;
+};
+
+// {@link IEventHandler} which can release events before the end of a batch,
+// e.g. once they are durably written, instead of holding the publishers
+// until the whole batch is processed.
+//
+// @param <T> event implementation storing the data for sharing during exchange
+// or parallel coordination of an event.
+template <typename T>
+class ISequenceReportingEventHandler : public IEventHandler<T>
+{
+public:
+    // Called by the {@link BatchEventProcessor} on construction, the
+    // callback is valid for the life time of the processor.
+    //
+    // @param sequence_callback to report the processed sequences to.
+    virtual void setSequenceCallback(ISequenceCallback* sequence_callback) = 0;
+};
+
+// Callback interface to be implemented for processing events as they become
+// available in the {@link RingBuffer}, where each event is handed to only
+// one of the {@link WorkProcessor}s of a {@link WorkerPool}.
+//
+// @param <T> event implementation storing the data for sharing during exchange
+// or parallel coordination of an event.
+template <typename T>
+class IWorkHandler
+{
+public:
+    virtual ~IWorkHandler() {};
+
+    // Called when a publisher has published an event to the {@link RingBuffer}
+    // and this handler's {@link WorkProcessor} has claimed it.
+    //
+    // @param sequence of the event being processed
+    // @param event published to the {@link RingBuffer}
+    //
+    // @throws Exception if the WorkHandler would like the exception handled
+    // further up the chain.
+    virtual void onEvent(const int64_t& sequence, T* event) = 0;
+
+    // Called once on thread start before processing the first event.
+    virtual void onStart() = 0;
+
+    // Called once on thread stop just before shutdown.
+    virtual void onShutdown() = 0;
+};
+
+// Callback interface for the events polled from the {@link RingBuffer} by
+// an {@link EventPoller}.
+//
+// @param <T> event implementation storing the data for sharing during exchange
+// or parallel coordination of an event.
+template <typename T>
+class IPollHandler
+{
+public:
+    virtual ~IPollHandler() {};
+
+    // Called for each available event during {@link EventPoller#poll()}.
+    //
+    // @param sequence of the event being processed
+    // @param end_of_batch flag to indicate if this is the last event of the
+    // poll
+    // @param event published to the {@link RingBuffer}
+    // @return true to keep processing events in this poll, false to stop
+    // after this event.
+    //
+    // @throws Exception which is propagated to the caller of poll.
+    virtual bool onEvent(const int64_t& sequence,
+                         const bool& end_of_batch,
+                         T* event) = 0;
+};
+
 // Implementations translate another data representations into events claimed
 // for the {@link RingBuffer}.
 //
@@ -269,6 +391,26 @@ public:
     // Signal those waiting that the cursor has advanced.
     virtual void signalAllWhenBlocking() = 0;
 
+    // Can those waiting block until signalled, publishers skip
+    // {@link #signalAllWhenBlocking()} on the strategies that can not.
+    //
+    // @return true unless signalAllWhenBlocking is a no-op.
+    virtual bool isBlocking() const { return true; }
+
+    // Register a barrier whose consumers will wait on the strategy, called
+    // by the {@link Sequencer} as it creates the barrier, for strategies
+    // holding resources per barrier.
+    //
+    // @param barrier the consumers will wait on.
+    // @throws std::exception if the barrier can not be waited on.
+    virtual void registerBarrier(const ISequenceBarrier& barrier) {}
+
+    // Release what was registered for a barrier, called by the
+    // {@link Sequencer} as the barrier is destroyed.
+    //
+    // @param barrier no longer waited on.
+    virtual void unregisterBarrier(const ISequenceBarrier& barrier) {}
+
 private:
     IWaitStrategy(const IWaitStrategy&);
     IWaitStrategy& operator= (IWaitStrategy);
@@ -276,6 +418,43 @@ private:
 
 typedef stdext::shared_ptr<IWaitStrategy> WaitStrategyPtr;
 
+// Strategy employed by publishers to wait for the {@link EventProcessor}s to
+// free a slot when the {@link RingBuffer} is full.
+class IProducerWaitStrategy
+{
+public:
+    virtual ~IProducerWaitStrategy() {};
+
+    // Wait for the slowest gating sequence to reach the wrap point.
+    //
+    // @param wrap_point the gating sequences must reach to free the slot.
+    // @param gating_sequences of the {@link EventProcessor}s.
+    // @return the minimum gating sequence, at least wrap_point.
+    virtual int64_t waitFor(const int64_t& wrap_point,
+                            const AtomicGatingSequences& gating_sequences) = 0;
+
+    // Wait for the cursor to reach sequence, for publishers bounding the
+    // publications they leave pending.
+    //
+    // @param sequence the cursor must reach.
+    // @param cursor of the {@link RingBuffer}.
+    // @return the cursor, at least sequence.
+    virtual int64_t waitFor(const int64_t& sequence, const Sequence& cursor) = 0;
+
+    // Signal the publishers waiting that the gating sequences or the cursor
+    // have advanced.
+    virtual void signalAllWhenBlocking() = 0;
+
+    // @return true unless signalAllWhenBlocking is a no-op.
+    virtual bool isBlocking() const = 0;
+
+private:
+    IProducerWaitStrategy(const IProducerWaitStrategy&);
+    IProducerWaitStrategy& operator= (IProducerWaitStrategy);
+};
+
+typedef stdext::shared_ptr<IProducerWaitStrategy> ProducerWaitStrategyPtr;
+
 
 }
 
@@ -0,0 +1,71 @@
+#ifndef DISRUPTOR_ATOMIC_SNAPSHOT_H_
+#define DISRUPTOR_ATOMIC_SNAPSHOT_H_
+
+#include <vector>
+
+#include <disruptor/utils.h>
+
+namespace disruptor {
+
+// Immutable object read by the publishers through a single pointer and
+// replaced by writers, e.g. the gating sequences of a {@link Sequencer}.
+//
+// Readers only load the pointer, with acquire ordering, and never pin the
+// snapshot, so a replaced snapshot may still be read and is not freed when
+// replaced. It is retired into a list freed at quiescence, by
+// {@link #reclaim()} once no reader can hold it, or with the
+// AtomicSnapshot. Snapshots are only replaced as consumers come and go,
+// which keeps the list short between reclaims.
+//
+// @param <T> type of the snapshot, owned by the AtomicSnapshot.
+template <typename T>
+class AtomicSnapshot
+{
+public:
+    // @param snapshot to be read until the first store.
+    explicit AtomicSnapshot(const T* snapshot) : current_(snapshot) {}
+
+    ~AtomicSnapshot()
+    {
+        reclaim();
+        delete current_.load(stdext::memory_order_relaxed);
+    }
+
+    // @return the current snapshot, valid until the next reclaim.
+    const T* load() const
+    {
+        return current_.load(stdext::memory_order_acquire);
+    }
+
+    // Replace the snapshot and retire the current one, writers must be
+    // serialised by the caller.
+    //
+    // @param snapshot to be read from now on.
+    void store(const T* snapshot)
+    {
+        retired_.push_back(current_.load(stdext::memory_order_relaxed));
+        current_.store(snapshot, stdext::memory_order_release);
+    }
+
+    // Free the retired snapshots. Serialised with the writers by the caller,
+    // and only called when no reader can still hold a replaced snapshot,
+    // e.g. once the publishers are joined.
+    void reclaim()
+    {
+        for (size_t i = 0; i < retired_.size(); ++i) {
+            delete retired_[i];
+        }
+        retired_.clear();
+    }
+
+private:
+    AtomicSnapshot(const AtomicSnapshot&);
+    AtomicSnapshot& operator= (AtomicSnapshot);
+
+    stdext::atomic<const T*> current_;
+    std::vector<const T*>    retired_;
+};
+
+}
+
+#endif
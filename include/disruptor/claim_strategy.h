@@ -2,6 +2,7 @@
 #define DISRUPTOR_CLAIM_STRATEGY_H_
 
 #include <disruptor/interface.h>
+#include <disruptor/producer_wait_strategy.h>
 
 namespace disruptor {
 
@@ -11,55 +12,73 @@ const int DEFAULT_RETRY_TIMES = 1000;
 enum ClaimStrategyOption {
     kSingleThreadedStrategy,
     kMultiThreadedStrategy,
-    kMultiThreadedLowContentionStrategy
+    kMultiThreadedLowContentionStrategy,
+    kMultiThreadedAvailabilityStrategy
 };
 
 // Optimised strategy can be used when there is a single publisher thread
 // claiming {@link AbstractEvent}s.
-class SingleThreadedStrategy : public IClaimStrategy
+//
+// @param <N> capacity of the buffer when fixed at compile time, so the wrap
+// checks subtract a constant, or 0 to take it from the constructor.
+template <int N = 0>
+class BasicSingleThreadedStrategy : public IClaimStrategy
 {
 public:
-    SingleThreadedStrategy(const int& buffer_size)
+    // @param buffer_size of the {@link RingBuffer}.
+    // @param producer_wait_strategy employed when the buffer is full.
+    BasicSingleThreadedStrategy(const int& buffer_size,
+            const ProducerWaitStrategyPtr& producer_wait_strategy =
+                ProducerWaitStrategyPtr(new YieldingProducerWaitStrategy()))
         : buffer_size_(buffer_size)
         , sequence_(INITIAL_CURSOR_VALUE)
         , min_gating_sequence_(INITIAL_CURSOR_VALUE)
+        , producer_wait_strategy_(producer_wait_strategy)
+        , producer_wait_blocking_(producer_wait_strategy->isBlocking())
+        , stalls_(0)
     {
     }
 
     virtual int64_t incrementAndGet(
-            const DependentSequences& dependent_sequences)
+            const AtomicGatingSequences& gating_sequences)
     {
         int64_t next_sequence = sequence_.incrementAndGet(1L);
-        waitForFreeSlotAt(next_sequence, dependent_sequences);
+        waitForFreeSlotAt(next_sequence, gating_sequences);
         return next_sequence;
     }
 
     virtual int64_t incrementAndGet(const int& delta,
-            const DependentSequences& dependent_sequences)
+            const AtomicGatingSequences& gating_sequences)
     {
         int64_t next_sequence = sequence_.incrementAndGet(delta);
-        waitForFreeSlotAt(next_sequence, dependent_sequences);
+        waitForFreeSlotAt(next_sequence, gating_sequences);
         return next_sequence;
     }
 
-    virtual bool hasAvailableCapacity(
-            const DependentSequences& dependent_sequences)
+    virtual bool tryIncrementAndGet(const int& delta,
+            const AtomicGatingSequences& gating_sequences,
+            int64_t& sequence)
     {
-        int64_t wrap_point = sequence_.get() + 1L - buffer_size_;
-        if (wrap_point > min_gating_sequence_.get()) {
-            int64_t min_sequence = getMinimumSequence(dependent_sequences);
-            min_gating_sequence_.set(min_sequence);
-            if (wrap_point > min_sequence)
-                return false;
+        int64_t next_sequence = sequence_.get() + delta;
+        if (!hasCapacityFor(next_sequence, gating_sequences)) {
+            return false;
         }
+        sequence_.set(next_sequence);
+        sequence = next_sequence;
         return true;
     }
 
+    virtual bool hasAvailableCapacity(
+            const AtomicGatingSequences& gating_sequences)
+    {
+        return hasCapacityFor(sequence_.get() + 1L, gating_sequences);
+    }
+
     virtual void setSequence(const int64_t& sequence,
-            const DependentSequences& dependent_sequences)
+            const AtomicGatingSequences& gating_sequences)
     {
         sequence_.set(sequence);
-        waitForFreeSlotAt(sequence, dependent_sequences);
+        waitForFreeSlotAt(sequence, gating_sequences);
     }
 
     virtual void serialisePublishing(const int64_t& sequence,
@@ -69,18 +88,56 @@ public:
         cursor.set(sequence);
     }
 
+    virtual int64_t getHighestPublishedSequence(const int64_t& lower_bound,
+            const int64_t& available_sequence) const
+    {
+        return available_sequence;
+    }
+
+    virtual void signalProducers()
+    {
+        if (producer_wait_blocking_) {
+            producer_wait_strategy_->signalAllWhenBlocking();
+        }
+    }
+
+    virtual int64_t getStallCount() const
+    {
+        return stalls_.load(stdext::memory_order_relaxed);
+    }
+
 private:
-    SingleThreadedStrategy();
+    BasicSingleThreadedStrategy();
+
+    int bufferSize() const { return N != 0 ? N : buffer_size_; }
+
+    bool hasCapacityFor(const int64_t& sequence,
+            const AtomicGatingSequences& gating_sequences)
+    {
+        int64_t wrap_point = sequence - bufferSize();
+        if (wrap_point > min_gating_sequence_.get()) {
+            int64_t min_sequence =
+                gating_sequences.getMinimumSequence(wrap_point);
+            min_gating_sequence_.set(min_sequence);
+            if (wrap_point > min_sequence)
+                return false;
+        }
+        return true;
+    }
 
     void waitForFreeSlotAt(const int64_t& sequence,
-            const DependentSequences& dependent_sequences)
+            const AtomicGatingSequences& gating_sequences)
     {
-        int64_t wrap_point = sequence - buffer_size_;
+        int64_t wrap_point = sequence - bufferSize();
         if (wrap_point > min_gating_sequence_.get()) {
-            int64_t min_sequence;
-            while (wrap_point >
-                    (min_sequence = getMinimumSequence(dependent_sequences))) {
-                stdext::this_thread::yield();
+            int64_t min_sequence =
+                gating_sequences.getMinimumSequence(wrap_point);
+            if (wrap_point > min_sequence) {
+                // single writer, no need for an atomic increment
+                stalls_.store(stalls_.load(stdext::memory_order_relaxed) + 1,
+                              stdext::memory_order_relaxed);
+                min_sequence = producer_wait_strategy_->waitFor(wrap_point,
+                        gating_sequences);
             }
             min_gating_sequence_.set(min_sequence);
         }
@@ -89,128 +146,198 @@ private:
     const int   buffer_size_;
     PaddedLong  sequence_;
     PaddedLong  min_gating_sequence_;
+    ProducerWaitStrategyPtr producer_wait_strategy_;
+    const bool  producer_wait_blocking_;
+    stdext::atomic<int64_t> stalls_;
 };
 
+typedef BasicSingleThreadedStrategy<> SingleThreadedStrategy;
+
 // Strategy to be used when there are multiple publisher threads claiming
 // {@link AbstractEvent}s.
-class MultiThreadedLowContentionStrategy : public IClaimStrategy
+//
+// @param <N> capacity of the buffer when fixed at compile time, or 0 to
+// take it from the constructor.
+template <int N = 0>
+class BasicMultiThreadedLowContentionStrategy : public IClaimStrategy
 {
 public:
-    MultiThreadedLowContentionStrategy(const int& buffer_size)
+    // @param buffer_size of the {@link RingBuffer}.
+    // @param producer_wait_strategy employed when the buffer is full, by
+    // default spinning 1000 times then sleeping 1ms between checks.
+    BasicMultiThreadedLowContentionStrategy(const int& buffer_size,
+            const ProducerWaitStrategyPtr& producer_wait_strategy =
+                ProducerWaitStrategyPtr(new SleepingProducerWaitStrategy(
+                    stdext::chrono::milliseconds(1))))
         : buffer_size_(buffer_size)
         , sequence_(INITIAL_CURSOR_VALUE)
         , min_gating_sequence_(INITIAL_CURSOR_VALUE)
-        , retries_(DEFAULT_RETRY_TIMES)
+        , producer_wait_strategy_(producer_wait_strategy)
+        , producer_wait_blocking_(producer_wait_strategy->isBlocking())
+        , stalls_(0)
     {
     }
 
     virtual int64_t incrementAndGet(
-            const DependentSequences& dependent_sequences)
+            const AtomicGatingSequences& gating_sequences)
     {
         int64_t next_sequence = sequence_.incrementAndGet(1L);
-        waitForFreeSlotAt(next_sequence, dependent_sequences);
+        waitForFreeSlotAt(next_sequence, gating_sequences);
         return next_sequence;
     }
 
     virtual int64_t incrementAndGet(const int& delta,
-            const DependentSequences& dependent_sequences) 
+            const AtomicGatingSequences& gating_sequences) 
     {
         int64_t next_sequence = sequence_.incrementAndGet(delta);
-        waitForFreeSlotAt(next_sequence, dependent_sequences);
+        waitForFreeSlotAt(next_sequence, gating_sequences);
         return next_sequence;
     }
 
     virtual void setSequence(const int64_t& sequence,
-            const DependentSequences& dependent_sequences)
+            const AtomicGatingSequences& gating_sequences)
     {
         sequence_.set(sequence);
-        waitForFreeSlotAt(sequence, dependent_sequences);
+        waitForFreeSlotAt(sequence, gating_sequences);
     }
 
-    virtual bool hasAvailableCapacity(
-            const DependentSequences& dependent_sequences)
+    virtual bool tryIncrementAndGet(const int& delta,
+            const AtomicGatingSequences& gating_sequences,
+            int64_t& sequence)
     {
-        const int64_t wrap_point = sequence_.get() + 1L - buffer_size_;
-        if (wrap_point > min_gating_sequence_.get()) {
-            int64_t min_sequence = getMinimumSequence(dependent_sequences);
-            min_gating_sequence_.set(min_sequence);
-            if (wrap_point > min_sequence)
+        int64_t current_sequence;
+        int64_t next_sequence;
+        do {
+            current_sequence = sequence_.get();
+            next_sequence = current_sequence + delta;
+            if (!hasCapacityFor(next_sequence, gating_sequences)) {
                 return false;
-        }
+            }
+        } while (!sequence_.compareAndExchange(current_sequence,
+                                               next_sequence));
+
+        sequence = next_sequence;
         return true;
     }
 
+    virtual bool hasAvailableCapacity(
+            const AtomicGatingSequences& gating_sequences)
+    {
+        return hasCapacityFor(sequence_.get() + 1L, gating_sequences);
+    }
+
     virtual void serialisePublishing(const int64_t& sequence,
                                      Sequence& cursor,
                                      const int64_t& batch_size)
     {
         int64_t expected_sequence = sequence - batch_size;
 
+        SpinBackoff backoff;
         while (expected_sequence != cursor.get()) {
+            backoff.pause();
         }
 
         cursor.set(sequence);
     }
 
+    virtual int64_t getHighestPublishedSequence(const int64_t& lower_bound,
+            const int64_t& available_sequence) const
+    {
+        return available_sequence;
+    }
+
+    virtual void signalProducers()
+    {
+        if (producer_wait_blocking_) {
+            producer_wait_strategy_->signalAllWhenBlocking();
+        }
+    }
+
+    virtual int64_t getStallCount() const
+    {
+        return stalls_.load(stdext::memory_order_relaxed);
+    }
+
 protected:
-    void waitForFreeSlotAt(const int64_t& sequence,
-                           const DependentSequences& dependent_sequences) 
+    int bufferSize() const { return N != 0 ? N : buffer_size_; }
+
+    bool hasCapacityFor(const int64_t& sequence,
+                        const AtomicGatingSequences& gating_sequences)
     {
-        const int64_t wrap_point = sequence - buffer_size_;
+        const int64_t wrap_point = sequence - bufferSize();
         if (wrap_point > min_gating_sequence_.get()) {
-            int counter = retries_;
-            int64_t min_sequence;
-            while (wrap_point >
-                    (min_sequence = getMinimumSequence(dependent_sequences))) {
-                if (counter > 0) {
-                    counter--;
-                }
-                else {
-                    stdext::this_thread::sleep(stdext::chrono::milliseconds(1));
-                }
-            }
+            int64_t min_sequence =
+                gating_sequences.getMinimumSequence(wrap_point);
             min_gating_sequence_.set(min_sequence);
+            if (wrap_point > min_sequence)
+                return false;
         }
+        return true;
     }
 
-    int applyBackPressure(int counter) 
+    void waitForFreeSlotAt(const int64_t& sequence,
+                           const AtomicGatingSequences& gating_sequences) 
     {
-        if (counter > 0) {
-            --counter;
-        }
-        else {
-            stdext::this_thread::sleep(stdext::chrono::milliseconds(1));
+        const int64_t wrap_point = sequence - bufferSize();
+        if (wrap_point > min_gating_sequence_.get()) {
+            int64_t min_sequence =
+                gating_sequences.getMinimumSequence(wrap_point);
+            if (wrap_point > min_sequence) {
+                stalls_.fetch_add(1, stdext::memory_order_relaxed);
+                min_sequence = producer_wait_strategy_->waitFor(wrap_point,
+                        gating_sequences);
+            }
+            min_gating_sequence_.set(min_sequence);
         }
-
-        return counter;
     }
 
     const int   buffer_size_;
     Sequence    sequence_;
     MutableLong min_gating_sequence_; // not atomic, but is safe enough for wrap checking
-    const int   retries_;
+    ProducerWaitStrategyPtr producer_wait_strategy_;
+    const bool  producer_wait_blocking_;
+    stdext::atomic<int64_t> stalls_;
 };
 
+typedef BasicMultiThreadedLowContentionStrategy<>
+    MultiThreadedLowContentionStrategy;
+
 
-class MultiThreadedStrategy : public MultiThreadedLowContentionStrategy
+// @param <N> capacity of the buffer when fixed at compile time, or 0 to
+// take it from the constructor.
+template <int N = 0>
+class BasicMultiThreadedStrategy
+    : public BasicMultiThreadedLowContentionStrategy<N>
 {
 public:
-    MultiThreadedStrategy(const int& buffer_size)
-        : MultiThreadedLowContentionStrategy(buffer_size)
-        , pending_size_(0)
-        , pending_mask_(0)
+    /**
+     * Construct a new multi-threaded publisher {@link ClaimStrategy} for a given buffer size.
+     *
+     * @param buffer_size for the underlying data structure.
+     * @param pending_buffer_size number of item that can be pending for serialisation
+     */
+    BasicMultiThreadedStrategy(const int& buffer_size,
+            int pending_buffer_size = DEFAULT_PENDING_BUFFER_SIZE)
+        : BasicMultiThreadedLowContentionStrategy<N>(buffer_size)
+        , pending_size_(ceilToPow2(pending_buffer_size))
+        , pending_publication_(new Sequence[pending_buffer_size])
+        , pending_mask_(pending_buffer_size - 1)
     {
     }
 
     /**
-     * Construct a new multi-threaded publisher {@link ClaimStrategy} for a given buffer size.
+     * Construct a new multi-threaded publisher {@link ClaimStrategy} with
+     * the strategy of the publishers waiting on a full buffer.
      *
      * @param buffer_size for the underlying data structure.
      * @param pending_buffer_size number of item that can be pending for serialisation
+     * @param producer_wait_strategy employed when the buffer is full.
      */
-    MultiThreadedStrategy(const int& buffer_size,
-            int pending_buffer_size = DEFAULT_PENDING_BUFFER_SIZE)
-        : MultiThreadedLowContentionStrategy(buffer_size)
+    BasicMultiThreadedStrategy(const int& buffer_size,
+            int pending_buffer_size,
+            const ProducerWaitStrategyPtr& producer_wait_strategy)
+        : BasicMultiThreadedLowContentionStrategy<N>(buffer_size,
+                                                     producer_wait_strategy)
         , pending_size_(ceilToPow2(pending_buffer_size))
         , pending_publication_(new Sequence[pending_buffer_size])
         , pending_mask_(pending_buffer_size - 1)
@@ -222,9 +349,10 @@ public:
                                      const int64_t& batch_size)
     {
         // Guard condition, limit the number of pending publications
-        int counter = retries_;
-        while (sequence - cursor.get() > pending_size_) {
-            counter = applyBackPressure(counter);
+        const int64_t pending_point = sequence - pending_size_;
+        if (pending_point > cursor.get()) {
+            this->stalls_.fetch_add(1, stdext::memory_order_relaxed);
+            this->producer_wait_strategy_->waitFor(pending_point, cursor);
         }
 
         // Transition from unpublished -> pending
@@ -254,6 +382,9 @@ public:
                 break;
             }
         }
+
+        // publishers may be parked on the cursor by the guard
+        this->signalProducers();
     }
 
 private:
@@ -262,26 +393,291 @@ private:
     const int64_t   pending_mask_;
 };
 
+typedef BasicMultiThreadedStrategy<> MultiThreadedStrategy;
+
+
+// Strategy to be used when there are multiple publisher threads claiming
+// {@link AbstractEvent}s and publishers must never wait on each other.
+//
+// Instead of serialising on the cursor, each publisher marks its slots in a
+// per-slot availability buffer and moves the cursor forward if it is behind.
+// The cursor then only bounds the published range, {@link EventProcessor}s
+// scan the availability buffer for the highest contiguous published sequence.
+//
+// @param <N> capacity of the buffer when fixed at compile time, or 0 to
+// take it from the constructor.
+template <int N = 0>
+class BasicMultiThreadedAvailabilityStrategy
+    : public BasicMultiThreadedLowContentionStrategy<N>
+{
+public:
+    BasicMultiThreadedAvailabilityStrategy(const int& buffer_size,
+            const ProducerWaitStrategyPtr& producer_wait_strategy =
+                ProducerWaitStrategyPtr(new SleepingProducerWaitStrategy(
+                    stdext::chrono::milliseconds(1))))
+        : BasicMultiThreadedLowContentionStrategy<N>(buffer_size,
+                                                     producer_wait_strategy)
+        , index_mask_(buffer_size - 1)
+        , index_shift_(floorLog2(buffer_size))
+        , available_buffer_(new stdext::atomic<int32_t>[buffer_size])
+    {
+        for (int i = 0; i < buffer_size; ++i) {
+            available_buffer_[i].store(-1, stdext::memory_order_relaxed);
+        }
+    }
+
+    virtual void serialisePublishing(const int64_t& sequence,
+                                     Sequence& cursor,
+                                     const int64_t& batch_size)
+    {
+        for (int64_t available_sequence = sequence - batch_size + 1;
+             available_sequence <= sequence;
+             ++available_sequence) {
+            setAvailable(available_sequence);
+        }
+
+        // Only ever move the cursor forward, if another publisher has already
+        // moved it past this sequence there is nothing left to do.
+        int64_t cursor_sequence = cursor.get();
+        while (cursor_sequence < sequence
+                && !cursor.compareAndExchange(cursor_sequence, sequence)) {
+            cursor_sequence = cursor.get();
+        }
+    }
+
+    virtual int64_t getHighestPublishedSequence(const int64_t& lower_bound,
+            const int64_t& available_sequence) const
+    {
+        for (int64_t sequence = lower_bound;
+             sequence <= available_sequence;
+             ++sequence) {
+            if (!isAvailable(sequence)) {
+                return sequence - 1;
+            }
+        }
+
+        return available_sequence;
+    }
+
+private:
+    // The flag stored for a slot is the number of times the ring has
+    // wrapped, so a slot left over from the previous lap never reads as
+    // published.
+    int32_t availabilityFlag(const int64_t& sequence) const
+    {
+        return static_cast<int32_t>(sequence >> index_shift_);
+    }
+
+    void setAvailable(const int64_t& sequence)
+    {
+        available_buffer_[sequence & index_mask_].store(
+                availabilityFlag(sequence), stdext::memory_order_release);
+    }
+
+    bool isAvailable(const int64_t& sequence) const
+    {
+        return available_buffer_[sequence & index_mask_].load(
+                stdext::memory_order_acquire) == availabilityFlag(sequence);
+    }
+
+    const int64_t   index_mask_;
+    const int       index_shift_;
+#ifdef has_cplusplus11
+    std::unique_ptr<stdext::atomic<int32_t>[]> available_buffer_;
+#else
+    boost::scoped_array<stdext::atomic<int32_t> > available_buffer_;
+#endif
+};
+
+typedef BasicMultiThreadedAvailabilityStrategy<>
+    MultiThreadedAvailabilityStrategy;
+
+// Map a claim strategy to the same strategy with a capacity fixed at compile
+// time, for {@link FixedRingBuffer}. Strategies without a compile time
+// capacity, such as {@link RuntimeClaimStrategy}, are kept as they are.
+//
+// @param <ClaimStrategy> policy for publishers claiming entries.
+// @param <N> capacity of the buffer.
+template <typename ClaimStrategy, int N>
+struct FixedCapacityClaimStrategy
+{
+    typedef ClaimStrategy type;
+};
 
+template <int M, int N>
+struct FixedCapacityClaimStrategy<BasicSingleThreadedStrategy<M>, N>
+{
+    typedef BasicSingleThreadedStrategy<N> type;
+};
+
+template <int M, int N>
+struct FixedCapacityClaimStrategy<BasicMultiThreadedLowContentionStrategy<M>, N>
+{
+    typedef BasicMultiThreadedLowContentionStrategy<N> type;
+};
+
+template <int M, int N>
+struct FixedCapacityClaimStrategy<BasicMultiThreadedStrategy<M>, N>
+{
+    typedef BasicMultiThreadedStrategy<N> type;
+};
+
+template <int M, int N>
+struct FixedCapacityClaimStrategy<BasicMultiThreadedAvailabilityStrategy<M>, N>
+{
+    typedef BasicMultiThreadedAvailabilityStrategy<N> type;
+};
+
+
+// Create a claim strategy with its default producer wait strategy: yielding
+// for the single threaded strategy, spinning then sleeping 1ms for the
+// multi threaded ones.
 inline ClaimStrategyPtr createClaimStrategy(ClaimStrategyOption option,
                                             const int& buffer_size)
 {
     switch (option) {
         case kSingleThreadedStrategy:
-            return stdext::make_shared<SingleThreadedStrategy>(
+            return stdext::make_shared<SingleThreadedStrategy>(buffer_size);
+         case kMultiThreadedStrategy:
+            return stdext::make_shared<MultiThreadedStrategy>(buffer_size);
+         case kMultiThreadedLowContentionStrategy:
+            return stdext::make_shared<MultiThreadedLowContentionStrategy>(
                     buffer_size);
+         case kMultiThreadedAvailabilityStrategy:
+            return stdext::make_shared<MultiThreadedAvailabilityStrategy>(
+                    buffer_size);
+        default:
+            return ClaimStrategyPtr();
+    }
+}
+
+inline ClaimStrategyPtr createClaimStrategy(ClaimStrategyOption option,
+        const int& buffer_size,
+        const ProducerWaitStrategyPtr& producer_wait_strategy)
+{
+    switch (option) {
+        case kSingleThreadedStrategy:
+            return stdext::make_shared<SingleThreadedStrategy>(
+                    buffer_size, producer_wait_strategy);
          case kMultiThreadedStrategy:
             return stdext::make_shared<MultiThreadedStrategy>(
                     buffer_size,
-                    DEFAULT_PENDING_BUFFER_SIZE);
+                    DEFAULT_PENDING_BUFFER_SIZE,
+                    producer_wait_strategy);
          case kMultiThreadedLowContentionStrategy:
             return stdext::make_shared<MultiThreadedLowContentionStrategy>(
-                    buffer_size);
+                    buffer_size, producer_wait_strategy);
+         case kMultiThreadedAvailabilityStrategy:
+            return stdext::make_shared<MultiThreadedAvailabilityStrategy>(
+                    buffer_size, producer_wait_strategy);
         default:
             return ClaimStrategyPtr();
     }
 };
 
+// Claim strategy selected at run time from a {@link ClaimStrategyOption}.
+//
+// This is the claim policy of the option based {@link Sequencer}, every call
+// is forwarded through the {@link IClaimStrategy} interface. Use one of the
+// concrete strategies as the policy instead to have the calls inlined.
+class RuntimeClaimStrategy
+{
+public:
+    // Construct the default strategy, safe with any number of publishers.
+    //
+    // @param buffer_size of the {@link RingBuffer}.
+    explicit RuntimeClaimStrategy(const int& buffer_size)
+        : claim_strategy_(createClaimStrategy(kMultiThreadedStrategy,
+                                              buffer_size))
+        , producer_wait_blocking_(false)
+    {
+    }
+
+    RuntimeClaimStrategy(const int& buffer_size, ClaimStrategyOption option)
+        : claim_strategy_(createClaimStrategy(option, buffer_size))
+        , producer_wait_blocking_(false)
+    {
+    }
+
+    RuntimeClaimStrategy(const int& buffer_size,
+                         ClaimStrategyOption option,
+                         ProducerWaitStrategyOption producer_wait_option,
+                         const TimeConfig& timeConfig)
+        : producer_wait_blocking_(false)
+    {
+        ProducerWaitStrategyPtr producer_wait_strategy =
+            createProducerWaitStrategy(producer_wait_option, timeConfig);
+        claim_strategy_ = createClaimStrategy(option, buffer_size,
+                                              producer_wait_strategy);
+        producer_wait_blocking_ = producer_wait_strategy->isBlocking();
+    }
+
+    bool hasAvailableCapacity(const AtomicGatingSequences& gating_sequences)
+    {
+        return claim_strategy_->hasAvailableCapacity(gating_sequences);
+    }
+
+    int64_t incrementAndGet(const AtomicGatingSequences& gating_sequences)
+    {
+        return claim_strategy_->incrementAndGet(gating_sequences);
+    }
+
+    int64_t incrementAndGet(const int& delta,
+            const AtomicGatingSequences& gating_sequences)
+    {
+        return claim_strategy_->incrementAndGet(delta, gating_sequences);
+    }
+
+    bool tryIncrementAndGet(const int& delta,
+            const AtomicGatingSequences& gating_sequences,
+            int64_t& sequence)
+    {
+        return claim_strategy_->tryIncrementAndGet(delta,
+                gating_sequences, sequence);
+    }
+
+    void setSequence(const int64_t& sequence,
+            const AtomicGatingSequences& gating_sequences)
+    {
+        claim_strategy_->setSequence(sequence, gating_sequences);
+    }
+
+    void serialisePublishing(const int64_t& sequence,
+                             Sequence& cursor,
+                             const int64_t& batch_size)
+    {
+        claim_strategy_->serialisePublishing(sequence, cursor, batch_size);
+    }
+
+    int64_t getHighestPublishedSequence(const int64_t& lower_bound,
+            const int64_t& available_sequence) const
+    {
+        return claim_strategy_->getHighestPublishedSequence(lower_bound,
+                available_sequence);
+    }
+
+    void signalProducers()
+    {
+        if (producer_wait_blocking_) {
+            claim_strategy_->signalProducers();
+        }
+    }
+
+    int64_t getStallCount() const
+    {
+        return claim_strategy_->getStallCount();
+    }
+
+private:
+    RuntimeClaimStrategy(const RuntimeClaimStrategy&);
+    RuntimeClaimStrategy& operator= (RuntimeClaimStrategy);
+
+    ClaimStrategyPtr claim_strategy_;
+    // cached to skip the virtual call on the consumers' path unless a
+    // publisher can be parked
+    bool producer_wait_blocking_;
+};
+
 }
 
 #endif 
@@ -0,0 +1,167 @@
+#ifndef DISRUPTOR_CLOCK_H_
+#define DISRUPTOR_CLOCK_H_
+
+#include <stdint.h>
+#include <time.h>
+
+#include <disruptor/utils.h>
+
+namespace disruptor {
+
+static const int64_t NANOS_PER_SECOND = 1000L * 1000L * 1000L;
+
+// Number of {@link Deadline#expired()} calls between two reads of the clock.
+const int DEADLINE_CHECK_INTERVAL = 64;
+
+// Monotonic clock, unaffected by steps of the wall clock. Served from the
+// vDSO on Linux, so reading it costs tens of nanoseconds but no syscall.
+class MonotonicClock
+{
+public:
+    // @return nanoseconds since an unspecified point in the past.
+    static int64_t nanoTime()
+    {
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        return now.tv_sec * NANOS_PER_SECOND + now.tv_nsec;
+    }
+};
+
+#if defined(__i386__) || defined(__x86_64__)
+// Clock reading the time stamp counter, a handful of cycles per read. The
+// tick rate is calibrated once against the {@link MonotonicClock}, which
+// takes CALIBRATION_NANOS on the first read. As the clock of the timed waits
+// it is calibrated on startup, otherwise call {@link #calibrate()} at startup
+// to keep that out of a wait.
+//
+// Only meaningful on CPUs with an invariant TSC, synchronised across cores.
+class TscClock
+{
+public:
+    static const int64_t CALIBRATION_NANOS = 10L * 1000L * 1000L;
+
+    // @return nanoseconds since an unspecified point in the past.
+    static int64_t nanoTime()
+    {
+        const Calibration& calibration = getCalibration();
+        return calibration.base_nanos + static_cast<int64_t>(
+                (ticks() - calibration.base_ticks) *
+                calibration.nanos_per_tick);
+    }
+
+    static void calibrate() { getCalibration(); }
+
+    static uint64_t ticks() { return __builtin_ia32_rdtsc(); }
+
+private:
+    struct Calibration
+    {
+        Calibration()
+        {
+            base_nanos = MonotonicClock::nanoTime();
+            base_ticks = ticks();
+            int64_t end_nanos;
+            do {
+                end_nanos = MonotonicClock::nanoTime();
+            } while (end_nanos - base_nanos < CALIBRATION_NANOS);
+            nanos_per_tick = static_cast<double>(end_nanos - base_nanos) /
+                (ticks() - base_ticks);
+        }
+
+        int64_t base_nanos;
+        uint64_t base_ticks;
+        double nanos_per_tick;
+    };
+
+    static const Calibration& getCalibration()
+    {
+        static const Calibration calibration;
+        return calibration;
+    }
+};
+#endif
+
+// Clock of the timed waits, the {@link TscClock} when built with
+// DISRUPTOR_TSC_CLOCK on x86, the {@link MonotonicClock} otherwise.
+#if defined(DISRUPTOR_TSC_CLOCK) && (defined(__i386__) || defined(__x86_64__))
+typedef TscClock WaitClock;
+
+namespace {
+// calibrates the TscClock during static initialisation, so that no timed
+// wait pays for it.
+const bool tsc_clock_calibrated = (TscClock::calibrate(), true);
+}
+#else
+typedef MonotonicClock WaitClock;
+#endif
+
+// Deadline of a timed wait, cheap enough to poll on every iteration of a
+// spin loop: the deadline is set from the clock on construction, then the
+// clock is only read every check_interval calls of {@link #expired()}.
+//
+// A wait polls {@link #expired()} once per iteration, so it overshoots the
+// timeout by up to check_interval iterations. Loops whose iterations cost
+// more than a clock read, such as yielding or pausing ones, should check on
+// every call.
+template <typename Clock>
+class BasicDeadline
+{
+public:
+    // @param timeout of the wait.
+    // @param check_interval number of {@link #expired()} calls per read of
+    // the clock.
+    explicit BasicDeadline(const stdext::chrono::nanoseconds& timeout,
+                           int check_interval = DEADLINE_CHECK_INTERVAL)
+        : deadline_nanos_(Clock::nanoTime() + timeout.count())
+        , check_interval_(check_interval)
+        , countdown_(check_interval)
+    {
+    }
+
+    // @return true once the timeout has passed since construction.
+    bool expired()
+    {
+        if (--countdown_ > 0) {
+            return false;
+        }
+        countdown_ = check_interval_;
+        return Clock::nanoTime() >= deadline_nanos_;
+    }
+
+    // Read the clock for the time left, e.g. to hand the rest of a wait over
+    // to another strategy or to a timed syscall.
+    //
+    // @return the nanoseconds left until the deadline, 0 once passed.
+    int64_t remainingNanos() const
+    {
+        int64_t remaining = deadline_nanos_ - Clock::nanoTime();
+        return remaining > 0 ? remaining : 0;
+    }
+
+    // Get the time left as the relative timeout of a timed syscall, such as
+    // a futex wait or a ppoll.
+    //
+    // @param timeout filled with the time left until the deadline.
+    // @return false once the deadline has passed.
+    bool remaining(struct timespec& timeout) const
+    {
+        int64_t remaining_nanos = remainingNanos();
+        if (remaining_nanos == 0) {
+            return false;
+        }
+        timeout.tv_sec = remaining_nanos / NANOS_PER_SECOND;
+        timeout.tv_nsec = remaining_nanos % NANOS_PER_SECOND;
+        return true;
+    }
+
+private:
+    const int64_t deadline_nanos_;
+    const int check_interval_;
+    int countdown_;
+};
+
+typedef BasicDeadline<WaitClock> Deadline;
+
+}
+
+#endif
@@ -1,8 +1,11 @@
 #ifndef DISRUPTOR_DISRUPTOR_H
 #define DISRUPTOR_DISRUPTOR_H
 
+#include <algorithm>
 #include <exception>
 #include <iostream>
+#include <stdexcept>
+#include <vector>
 
 #include <disruptor/ring_buffer.h>
 #include <disruptor/event_publisher.h>
@@ -14,10 +17,97 @@ namespace disruptor {
 
 const int DEFAULT_MAX_IDLE_TIME_US = 10;
 
+template <typename T>
+class Disruptor;
+
+// A group of {@link EventProcessor}s used as part of the {@link Disruptor},
+// through which further handlers can be chained after the group.
+//
+// @param <T> event implementation storing the data for sharing during
+// exchange or parallel coordination of an event.
+template <typename T>
+class EventHandlerGroup
+{
+    public:
+        EventHandlerGroup(Disruptor<T>* disruptor,
+                          const DependentSequences& sequences)
+            : disruptor_(disruptor)
+            , sequences_(sequences)
+        {
+        }
+
+        // Set up batch handlers to consume events from the ring buffer.
+        // These handlers will only process events after every
+        // {@link EventProcessor} in this group has processed the event.
+        //
+        // @param handlers that will process events.
+        // @return a {@link EventHandlerGroup} that can be used to chain
+        // dependencies.
+        EventHandlerGroup<T> then(
+                const std::vector<IEventHandler<T>*>& handlers)
+        {
+            return disruptor_->createEventProcessors(sequences_, handlers);
+        }
+
+        EventHandlerGroup<T> then(IEventHandler<T>* a)
+        {
+            return then(std::vector<IEventHandler<T>*>(1, a));
+        }
+
+        EventHandlerGroup<T> then(IEventHandler<T>* a, IEventHandler<T>* b)
+        {
+            std::vector<IEventHandler<T>*> handlers(1, a);
+            handlers.push_back(b);
+            return then(handlers);
+        }
+
+        EventHandlerGroup<T> then(IEventHandler<T>* a, IEventHandler<T>* b,
+                                  IEventHandler<T>* c)
+        {
+            std::vector<IEventHandler<T>*> handlers(1, a);
+            handlers.push_back(b);
+            handlers.push_back(c);
+            return then(handlers);
+        }
+
+        // Create a new group combining the {@link EventProcessor}s of this
+        // group with those of another, so that handlers chained after it
+        // wait for both.
+        //
+        // @param other group to combine with.
+        // @return a {@link EventHandlerGroup} combining both groups.
+        EventHandlerGroup<T> with(const EventHandlerGroup<T>& other) const
+        {
+            DependentSequences sequences(sequences_);
+            sequences.insert(sequences.end(), other.sequences_.begin(),
+                             other.sequences_.end());
+            return EventHandlerGroup<T>(disruptor_, sequences);
+        }
+
+        // @return the sequences of the {@link EventProcessor}s in this group.
+        const DependentSequences& getSequences() const { return sequences_; }
+
+    private:
+        Disruptor<T>*       disruptor_;
+        DependentSequences  sequences_;
+};
+
+// Facade wiring {@link BatchEventProcessor}s to a {@link RingBuffer}.
+//
+// Handlers are arranged in a dependency graph, e.g.
+//
+//   disruptor.handleEventsWith(&journal, &replicate).then(&logic);
+//   disruptor.start();
+//
+// Each group of handlers waits on a barrier tracking the groups it follows,
+// and the publishers are only gated on the handlers at the end of a chain.
+// The {@link Disruptor} owns the threads running the processors.
 template <typename T>
 class Disruptor
 {
     public:
+        typedef BatchEventProcessor<T> processor_type;
+
         // will start after construct
         Disruptor(int size,
                   ClaimStrategyOption claimStrategy,
@@ -26,51 +116,237 @@ class Disruptor
                   IExceptionHandler<T> * exceptHandler,
                   const TimeConfig& timeConfig = TimeConfig())
             : ring_buffer_(size, claimStrategy, waitStrategy, timeConfig)
-            , barrier_(ring_buffer_.newBarrier(DependentSequences()))
-            , processor_(&ring_buffer_, barrier_, handler, exceptHandler,
-                         getTimeConfig(timeConfig, kMaxIdle,
-                                       stdext::chrono::microseconds(
-                                           DEFAULT_MAX_IDLE_TIME_US)))
             , publisher_(&ring_buffer_)
-            , consumer_thread_(stdext::ref< BatchEventProcessor<T> >(processor_))
+            , exception_handler_(exceptHandler)
+            , max_idle_time_(getTimeConfig(timeConfig, kMaxIdle,
+                                           stdext::chrono::microseconds(
+                                               DEFAULT_MAX_IDLE_TIME_US)))
+            , started_(false)
+            , stopped_(false)
+        {
+            handleEventsWith(handler);
+            start();
+        }
+
+        // Build the handler graph with {@link #handleEventsWith()}, then
+        // {@link #start()}.
+        Disruptor(int size,
+                  ClaimStrategyOption claimStrategy,
+                  WaitStrategyOption waitStrategy,
+                  const TimeConfig& timeConfig = TimeConfig())
+            : ring_buffer_(size, claimStrategy, waitStrategy, timeConfig)
+            , publisher_(&ring_buffer_)
+            , exception_handler_(NULL)
+            , max_idle_time_(getTimeConfig(timeConfig, kMaxIdle,
+                                           stdext::chrono::microseconds(
+                                               DEFAULT_MAX_IDLE_TIME_US)))
+            , started_(false)
             , stopped_(false)
         {
-            ring_buffer_.setGatingSequences(
-                    DependentSequences(1, processor_.getSequence())
-                    );
         }
 
         virtual ~Disruptor()
         {
-            if(!stopped_) {
+            if(started_ && !stopped_) {
                 this->stop();
             }
         }
 
+        // Set up batch handlers to consume events from the ring buffer.
+        // These handlers will process events as soon as they become
+        // available, in parallel.
+        //
+        // @param handlers that will process events.
+        // @return a {@link EventHandlerGroup} that can be used to chain
+        // dependencies.
+        EventHandlerGroup<T> handleEventsWith(
+                const std::vector<IEventHandler<T>*>& handlers)
+        {
+            return createEventProcessors(DependentSequences(), handlers);
+        }
+
+        EventHandlerGroup<T> handleEventsWith(IEventHandler<T>* a)
+        {
+            return handleEventsWith(std::vector<IEventHandler<T>*>(1, a));
+        }
+
+        EventHandlerGroup<T> handleEventsWith(IEventHandler<T>* a,
+                                              IEventHandler<T>* b)
+        {
+            std::vector<IEventHandler<T>*> handlers(1, a);
+            handlers.push_back(b);
+            return handleEventsWith(handlers);
+        }
+
+        EventHandlerGroup<T> handleEventsWith(IEventHandler<T>* a,
+                                              IEventHandler<T>* b,
+                                              IEventHandler<T>* c)
+        {
+            std::vector<IEventHandler<T>*> handlers(1, a);
+            handlers.push_back(b);
+            handlers.push_back(c);
+            return handleEventsWith(handlers);
+        }
+
+        // Create a group of already added handlers, so that handlers can be
+        // chained after all of them, e.g. to join the branches of a diamond.
+        //
+        // @param handlers that were previously set up with
+        // {@link #handleEventsWith()} or {@link EventHandlerGroup#then()}.
+        // @return a {@link EventHandlerGroup} over the handlers.
+        //
+        // @throws std::invalid_argument if a handler has not been set up.
+        EventHandlerGroup<T> after(
+                const std::vector<IEventHandler<T>*>& handlers)
+        {
+            DependentSequences sequences;
+            for (size_t i = 0; i < handlers.size(); ++i) {
+                sequences.push_back(getSequenceFor(handlers[i]));
+            }
+            return EventHandlerGroup<T>(this, sequences);
+        }
+
+        EventHandlerGroup<T> after(IEventHandler<T>* a)
+        {
+            return after(std::vector<IEventHandler<T>*>(1, a));
+        }
+
+        EventHandlerGroup<T> after(IEventHandler<T>* a, IEventHandler<T>* b)
+        {
+            std::vector<IEventHandler<T>*> handlers(1, a);
+            handlers.push_back(b);
+            return after(handlers);
+        }
+
+        // Specify the exception handler of the processors created from now
+        // on.
+        //
+        // @param exception_handler to use.
+        void handleExceptionsWith(IExceptionHandler<T>* exception_handler)
+        {
+            exception_handler_ = exception_handler;
+        }
+
+        // Gate the publishers on the handlers at the end of each chain and
+        // start one thread per {@link EventProcessor}.
+        //
+        // @throws std::runtime_error if already started or no handler is set
+        // up, the publishers would not be gated on anything.
+        void start()
+        {
+            if (started_) {
+                throw std::runtime_error("Disruptor has already been started");
+            }
+            if (consumers_.empty()) {
+                throw std::runtime_error("No event handler is set up");
+            }
+            started_ = true;
+
+            DependentSequences gating_sequences;
+            for (size_t i = 0; i < consumers_.size(); ++i) {
+                if (consumers_[i].end_of_chain) {
+                    gating_sequences.push_back(
+                            consumers_[i].processor->getSequence());
+                }
+            }
+            ring_buffer_.setGatingSequences(gating_sequences);
+
+            for (size_t i = 0; i < consumers_.size(); ++i) {
+                threads_.push_back(stdext::shared_ptr<stdext::thread>(
+                            new stdext::thread(stdext::ref<processor_type>(
+                                    *consumers_[i].processor))));
+            }
+        }
+
+        // Get the {@link Sequence} of the processor running a handler.
+        //
+        // @param handler that was set up on this {@link Disruptor}.
+        // @return the sequence processed up to by the handler.
+        //
+        // @throws std::invalid_argument if the handler has not been set up.
+        Sequence* getSequenceFor(IEventHandler<T>* handler)
+        {
+            return findConsumer(handler).processor->getSequence();
+        }
+
         void publishEvent(IEventTranslator<T>* translator)
         {
             publisher_.publishEvent(translator);
         }
 
+        void publishEvents(IEventTranslator<T>* const* translators,
+                           const int& n)
+        {
+            publisher_.publishEvents(translators, n);
+        }
+
         bool tryPublishEvent(IEventTranslator<T>* translator)
         {
             return publisher_.tryPublishEvent(translator);
         }
 
+        bool tryPublishEvents(IEventTranslator<T>* const* translators,
+                              const int& n)
+        {
+            return publisher_.tryPublishEvents(translators, n);
+        }
+
+#ifdef has_cplusplus11
+        template <typename F, typename... Args>
+        typename EnableIfCallable<T, F>::type
+        publishEvent(F&& f, Args&&... args)
+        {
+            publisher_.publishEvent(std::forward<F>(f),
+                                    std::forward<Args>(args)...);
+        }
+
+        template <typename F, typename... Args>
+        typename EnableIfCallable<T, F, bool>::type
+        tryPublishEvent(F&& f, Args&&... args)
+        {
+            return publisher_.tryPublishEvent(std::forward<F>(f),
+                                              std::forward<Args>(args)...);
+        }
+
+        template <typename F>
+        typename EnableIfCallable<T, F>::type
+        publishEvents(F&& f, const int& n)
+        {
+            publisher_.publishEvents(std::forward<F>(f), n);
+        }
+
+        template <typename F>
+        typename EnableIfCallable<T, F, bool>::type
+        tryPublishEvents(F&& f, const int& n)
+        {
+            return publisher_.tryPublishEvents(std::forward<F>(f), n);
+        }
+#endif
+
         bool full() const
         {
             return !publisher_.hasAvailableCapacity();
         }
 
+        // @return the first {@link BatchEventProcessor} set up.
+        //
+        // @throws std::runtime_error if no handler is set up.
         BatchEventProcessor<T>& processor()
         {
-            return processor_;
+            if (consumers_.empty()) {
+                throw std::runtime_error("No event handler is set up");
+            }
+            return *consumers_.front().processor;
         }
 
         void stop()
         {
-            processor_.halt();
-            consumer_thread_.join();
+            for (size_t i = 0; i < consumers_.size(); ++i) {
+                consumers_[i].processor->halt();
+            }
+            for (size_t i = 0; i < threads_.size(); ++i) {
+                threads_[i]->join();
+            }
             stopped_ = true;
         }
 
@@ -80,12 +356,73 @@ class Disruptor
         }
 
     private:
-        RingBuffer<T>           ring_buffer_;
-        SequenceBarrierPtr      barrier_;
-        BatchEventProcessor<T>  processor_;
-        EventPublisher<T>       publisher_;
-        stdext::thread           consumer_thread_;
-        bool                    stopped_;
+        friend class EventHandlerGroup<T>;
+
+        struct ConsumerInfo
+        {
+            IEventHandler<T>*                  handler;
+            stdext::shared_ptr<processor_type> processor;
+            bool                               end_of_chain;
+        };
+
+        Disruptor(const Disruptor& d);
+        Disruptor& operator= (Disruptor d);
+
+        EventHandlerGroup<T> createEventProcessors(
+                const DependentSequences& barrier_sequences,
+                const std::vector<IEventHandler<T>*>& handlers)
+        {
+            if (started_) {
+                throw std::runtime_error(
+                        "All event handlers must be added before start");
+            }
+
+            // the processors this group follows no longer gate the publishers
+            for (size_t i = 0; i < consumers_.size(); ++i) {
+                Sequence* sequence = consumers_[i].processor->getSequence();
+                if (std::find(barrier_sequences.begin(),
+                              barrier_sequences.end(),
+                              sequence) != barrier_sequences.end()) {
+                    consumers_[i].end_of_chain = false;
+                }
+            }
+
+            stdext::shared_ptr<ProcessingSequenceBarrier> barrier =
+                ring_buffer_.newBarrier(barrier_sequences);
+
+            DependentSequences sequences;
+            for (size_t i = 0; i < handlers.size(); ++i) {
+                ConsumerInfo consumer;
+                consumer.handler = handlers[i];
+                consumer.processor.reset(new processor_type(&ring_buffer_,
+                            barrier, handlers[i], exception_handler_,
+                            max_idle_time_));
+                consumer.end_of_chain = true;
+                consumers_.push_back(consumer);
+                sequences.push_back(consumer.processor->getSequence());
+            }
+
+            return EventHandlerGroup<T>(this, sequences);
+        }
+
+        const ConsumerInfo& findConsumer(IEventHandler<T>* handler) const
+        {
+            for (size_t i = 0; i < consumers_.size(); ++i) {
+                if (consumers_[i].handler == handler) {
+                    return consumers_[i];
+                }
+            }
+            throw std::invalid_argument("Event handler is not set up");
+        }
+
+        RingBuffer<T>                   ring_buffer_;
+        EventPublisher<T>               publisher_;
+        IExceptionHandler<T>*           exception_handler_;
+        stdext::chrono::microseconds    max_idle_time_;
+        std::vector<ConsumerInfo>       consumers_;
+        std::vector<stdext::shared_ptr<stdext::thread> > threads_;
+        bool                            started_;
+        bool                            stopped_;
 };
 
 
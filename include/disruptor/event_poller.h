@@ -0,0 +1,123 @@
+#ifndef DISRUPTOR_EVENT_POLLER_H_
+#define DISRUPTOR_EVENT_POLLER_H_
+
+#include <disruptor/ring_buffer.h>
+
+
+namespace disruptor {
+
+// Outcome of a {@link EventPoller#poll()}.
+enum PollState {
+    // events were processed.
+    kProcessing,
+    // events are published but not yet released by the sequences the
+    // poller depends on.
+    kGating,
+    // nothing has been published since the last poll.
+    kIdle
+};
+
+// Pull based consumer of a {@link RingBuffer}, for draining it from a thread
+// that runs its own loop, e.g. an epoll loop, instead of dedicating a thread
+// to a {@link BatchEventProcessor}.
+//
+// The poller never waits: {@link #poll()} processes what is available and
+// returns, advancing the poller's {@link Sequence} once per call.
+//
+// @param <T> event implementation storing the data for sharing during
+// exchange or parallel coordination of an event.
+// @param <RingBufferType> the {@link RingBuffer} instance consumed from.
+template <typename T, typename RingBufferType = RingBuffer<T> >
+class EventPoller
+{
+public:
+    typedef typename RingBufferType::barrier_type barrier_type;
+
+    // Construct a poller of ring_buffer.
+    //
+    // @param ring_buffer to consume from.
+    // @param sequence_barrier tracking the sequences the poller follows.
+    // @param max_batch_size of events processed by one poll.
+    EventPoller(RingBufferType* ring_buffer,
+                stdext::shared_ptr<barrier_type> sequence_barrier,
+                const int64_t& max_batch_size = LONG_MAX)
+        : ring_buffer_(ring_buffer)
+        , sequence_barrier_(sequence_barrier)
+        , max_batch_size_(max_batch_size)
+    {
+        if (max_batch_size < 1) {
+            throw std::invalid_argument("max_batch_size must be > 0");
+        }
+    }
+
+    // Get a pointer to the {@link Sequence} of the poller, to be set as a
+    // gating sequence of the {@link RingBuffer}.
+    //
+    // @return pointer to the {@link Sequence} of the poller.
+    Sequence* getSequence() { return &sequence_; }
+
+    // Process the available events, at most max_batch_size of them, until
+    // the handler asks to stop.
+    //
+    // @param handler to which the events are dispatched.
+    // @return kProcessing if any event was processed, kGating if events are
+    // published but held back by the sequences the poller follows, kIdle
+    // otherwise.
+    //
+    // @throws the exceptions of the handler, the events processed before the
+    // one that failed are consumed.
+    PollState poll(IPollHandler<T>* handler)
+    {
+        int64_t current_sequence = sequence_.get();
+        int64_t next_sequence = current_sequence + 1L;
+        int64_t available_sequence =
+            sequence_barrier_->barrier_type::getAvailableSequence(
+                    next_sequence);
+
+        if (next_sequence <= available_sequence) {
+            if (available_sequence - next_sequence >= max_batch_size_) {
+                available_sequence = next_sequence + max_batch_size_ - 1;
+            }
+
+            int64_t processed_sequence = current_sequence;
+            try {
+                bool process_next_event;
+                do {
+                    T* event = ring_buffer_->get(next_sequence);
+                    process_next_event = handler->onEvent(next_sequence,
+                            next_sequence == available_sequence, event);
+                    processed_sequence = next_sequence;
+                    next_sequence++;
+                } while (next_sequence <= available_sequence &&
+                         process_next_event);
+            }
+            catch(...) {
+                sequence_.set(processed_sequence);
+                throw;
+            }
+
+            sequence_.set(processed_sequence);
+            sequence_barrier_->barrier_type::signalProducers();
+            return kProcessing;
+        }
+        else if (sequence_barrier_->barrier_type::getCursor() >=
+                 next_sequence) {
+            return kGating;
+        }
+
+        return kIdle;
+    }
+
+private:
+    EventPoller(const EventPoller& e);
+    EventPoller& operator= (EventPoller e);
+
+    Sequence                         sequence_;
+    RingBufferType*                  ring_buffer_;
+    stdext::shared_ptr<barrier_type> sequence_barrier_;
+    const int64_t                    max_batch_size_;
+};
+
+}
+
+#endif
@@ -7,22 +7,81 @@
 namespace disruptor {
 
 
-template <typename T>
+// Convenience class for handling the batching semantics of consuming
+// entries from a {@link RingBuffer} and delegating the available events to a
+// {@link EventHandler}.
+//
+// The sequence of the processor is set at the end of each batch, holding the
+// publishers until the whole batch is handled. With a progress interval it is
+// also set every progress_interval events, and a
+// {@link ISequenceReportingEventHandler} can set it itself through its
+// sequence callback, e.g. once the events are durably written.
+//
+// A max batch size caps the events handled from one wait: the last event
+// before the cap is flagged end_of_batch and the batch completes, sequence
+// and idle callback included, before the rest is handled. This bounds the
+// delay of end of batch actions such as network flushes.
+//
+// With a prefetch distance, the processor prefetches the event
+// prefetch_distance slots ahead of the one it hands to the handler, within
+// the available batch, so large events written by a publisher on another
+// core are on their way by the time they are handled.
+//
+// @param <T> event implementation storing the data for sharing during
+// exchange or parallel coordination of an event.
+// @param <RingBufferType> the {@link RingBuffer} instance consumed from, its
+// barrier type is called directly so the wait path can be inlined.
+template <typename T, typename RingBufferType = RingBuffer<T> >
 class BatchEventProcessor : public IEventProcessor<T>
 {
 public:
-    BatchEventProcessor(RingBuffer<T>* ring_buffer,
-                        SequenceBarrierPtr sequence_barrier,
+    typedef typename RingBufferType::barrier_type barrier_type;
+
+    // Construct a processor consuming ring_buffer through sequence_barrier.
+    //
+    // @param max_idle_time after which the handler is called with a NULL
+    // event when nothing was published, 0 to only wait for events.
+    // @param progress_interval number of events after which the sequence is
+    // set in the middle of a batch, 0 to only set it at the end of batches.
+    // @param max_batch_size of events handled as one batch, 0 for no limit.
+    // @param prefetch_distance number of slots prefetched ahead of the
+    // handled event, 0 not to prefetch.
+    //
+    // @throws std::invalid_argument if progress_interval, max_batch_size or
+    // prefetch_distance < 0.
+    BatchEventProcessor(RingBufferType* ring_buffer,
+                        stdext::shared_ptr<barrier_type> sequence_barrier,
                         IEventHandler<T>* event_handler,
                         IExceptionHandler<T>* exception_handler,
-                        const stdext::chrono::milliseconds& max_idle_time)
+                        const stdext::chrono::milliseconds& max_idle_time,
+                        int progress_interval = 0,
+                        int max_batch_size = 0,
+                        int prefetch_distance = 0)
         : running_(false)
         , ring_buffer_(ring_buffer)
         , sequence_barrier_(sequence_barrier)
         , event_handler_(event_handler)
         , exception_handler_(exception_handler)
         , wait_(max_idle_time)
+        , progress_interval_(progress_interval)
+        , max_batch_size_(max_batch_size)
+        , prefetch_distance_(prefetch_distance)
+        , sequence_callback_(this)
     {
+        if (progress_interval < 0) {
+            throw std::invalid_argument("progress_interval must be >= 0");
+        }
+        if (max_batch_size < 0) {
+            throw std::invalid_argument("max_batch_size must be >= 0");
+        }
+        if (prefetch_distance < 0) {
+            throw std::invalid_argument("prefetch_distance must be >= 0");
+        }
+        ISequenceReportingEventHandler<T>* reporting_handler =
+            dynamic_cast<ISequenceReportingEventHandler<T>*>(event_handler);
+        if (reporting_handler) {
+            reporting_handler->setSequenceCallback(&sequence_callback_);
+        }
     }
 
     virtual Sequence* getSequence() { return &sequence_; }
@@ -38,13 +97,42 @@ private:
     BatchEventProcessor(const BatchEventProcessor& b);
     BatchEventProcessor& operator= (BatchEventProcessor b);
 
+    // Sequence callback handed to a {@link ISequenceReportingEventHandler}.
+    class SequenceCallback : public ISequenceCallback
+    {
+    public:
+        explicit SequenceCallback(BatchEventProcessor* processor)
+            : processor_(processor)
+        {
+        }
+
+        virtual void set(const int64_t& sequence)
+        {
+            processor_->release(sequence);
+        }
+
+    private:
+        BatchEventProcessor* processor_;
+    };
+
+    // Set the sequence of the processor and wake the publishers it gates.
+    void release(const int64_t& sequence)
+    {
+        sequence_.set(sequence);
+        sequence_barrier_->barrier_type::signalProducers();
+    }
+
     stdext::atomic<bool>         running_;
     Sequence                     sequence_;
-    RingBuffer<T>*               ring_buffer_;
-    SequenceBarrierPtr           sequence_barrier_; // barrier is (share)owned by processors
+    RingBufferType*              ring_buffer_;
+    stdext::shared_ptr<barrier_type> sequence_barrier_; // barrier is (share)owned by processors
     IEventHandler<T>*            event_handler_;
     IExceptionHandler<T>*        exception_handler_;
     stdext::chrono::microseconds wait_; 
+    const int                    progress_interval_;
+    const int                    max_batch_size_;
+    const int                    prefetch_distance_;
+    SequenceCallback             sequence_callback_;
 };
 
 
@@ -52,14 +140,16 @@ private:
 // implementation
 //
 
-void BatchEventProcessor::halt()
+template <typename T, typename RingBufferType>
+void BatchEventProcessor<T, RingBufferType>::halt()
 {
     running_.store(false);
     sequence_barrier_->alert();
 }
 
 
-void BatchEventProcessor::run()
+template <typename T, typename RingBufferType>
+void BatchEventProcessor<T, RingBufferType>::run()
 {
     bool expected = false;
     if (!running_.compare_exchange_strong(expected, true)) {
@@ -77,15 +167,38 @@ void BatchEventProcessor::run()
     while (true) {
         try {
             int64_t available_sequence =
-                sequence_barrier_->waitFor(next_sequence, wait_);
+                sequence_barrier_->barrier_type::waitFor(next_sequence, wait_);
+            if (max_batch_size_ > 0 &&
+                    available_sequence - next_sequence >= max_batch_size_) {
+                available_sequence = next_sequence + max_batch_size_ - 1;
+            }
 
             int64_t batch_size = available_sequence - next_sequence + 1;
+            // next sequence to release in the middle of the batch
+            int64_t progress_sequence = progress_interval_ > 0 ?
+                next_sequence + progress_interval_ - 1 : LONG_MAX;
+            // next sequence to prefetch, the first prefetch_distance slots
+            // of the batch are prefetched up front
+            int64_t prefetch_sequence = next_sequence;
+            for (int i = 0; i < prefetch_distance_ &&
+                    prefetch_sequence <= available_sequence; ++i) {
+                ring_buffer_->prefetch(prefetch_sequence++);
+            }
 
             while (next_sequence <= available_sequence) {
+                if (prefetch_distance_ > 0 &&
+                        prefetch_sequence <= available_sequence) {
+                    ring_buffer_->prefetch(prefetch_sequence++);
+                }
                 event = ring_buffer_->get(next_sequence);
                 event_handler_->onEvent(next_sequence,
                         batch_size,
                         next_sequence == available_sequence, event);
+                if (next_sequence == progress_sequence &&
+                        next_sequence != available_sequence) {
+                    release(next_sequence);
+                    progress_sequence += progress_interval_;
+                }
                 next_sequence++;
             }
 
@@ -98,7 +211,7 @@ void BatchEventProcessor::run()
                         NULL);
             }
 
-            sequence_.set(next_sequence - 1L);
+            release(next_sequence - 1L);
         }
         catch(const AlertException& e) {
             break;
@@ -107,7 +220,7 @@ void BatchEventProcessor::run()
             if (exception_handler_) {
                 exception_handler_->handle(e, next_sequence, event);
             }
-            sequence_.set(next_sequence);
+            release(next_sequence);
             next_sequence++;
         }
     }
@@ -1,15 +1,35 @@
 #ifndef DISRUPTOR_EVENT_PUBLISHER_H_
 #define DISRUPTOR_EVENT_PUBLISHER_H_
 
+#ifdef has_cplusplus11
+#include <type_traits>
+#include <utility>
+#else
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/has_trivial_copy.hpp>
+#endif
+
 #include <disruptor/ring_buffer.h>
 
 namespace disruptor {
 
-template<typename T>
+#ifdef has_cplusplus11
+// Enables the callable publishing overloads for anything that is not an
+// {@link EventTranslator} pointer or array, those keep resolving to the
+// virtual overloads.
+template <typename T, typename F, typename R = void>
+struct EnableIfCallable : std::enable_if<
+        !std::is_convertible<F, IEventTranslator<T>*>::value
+        && !std::is_convertible<F, IEventTranslator<T>* const*>::value, R>
+{
+};
+#endif
+
+template<typename T, typename RingBufferType = RingBuffer<T> >
 class EventPublisher
 {
 public:
-    EventPublisher(RingBuffer<T>* ring_buffer)
+    EventPublisher(RingBufferType* ring_buffer)
         : ring_buffer_(ring_buffer)
     {
     }
@@ -22,18 +42,163 @@ public:
         ring_buffer_->publish(sequence);
     }
 
+    // Publish a burst of events with one claim, one cursor update and one
+    // wake-up of the waiting {@link EventProcessor}s.
+    //
+    // @param translators one translator per event, in publishing order.
+    // @param n number of events to publish, at most the buffer capacity.
+    void publishEvents(IEventTranslator<T>* const* translators, const int& n)
+    {
+        int64_t hi = ring_buffer_->next(n);
+        int64_t lo = hi - n + 1;
+        for (int i = 0; i < n; ++i) {
+            translators[i]->translateTo(lo + i, ring_buffer_->get(lo + i));
+        }
+        ring_buffer_->publish(lo, hi);
+    }
+
+    // Publish a burst of events copied from events with non-temporal stores,
+    // with one claim, one cursor update and one wake-up. For large events
+    // the publisher never reads back, this keeps the copies out of its
+    // caches, the processors read them from memory instead. Pays off once
+    // the events in flight outgrow the caches, below that regular stores
+    // are faster.
+    //
+    // Only for trivially copyable events, copied byte for byte.
+    //
+    // @param events to copy into the claimed slots, in publishing order.
+    // @param n number of events to publish, at most the buffer capacity.
+    void publishEventsStreaming(const T* events, const int& n)
+    {
+#ifdef has_cplusplus11
+        static_assert(std::is_trivially_copyable<T>::value,
+                      "T must be trivially copyable");
+#else
+        BOOST_STATIC_ASSERT((boost::has_trivial_copy<T>::value));
+#endif
+        int64_t hi = ring_buffer_->next(n);
+        int64_t lo = hi - n + 1;
+        for (int i = 0; i < n; ++i) {
+            streamingCopy(ring_buffer_->get(lo + i), &events[i], sizeof(T));
+        }
+        streamingFence();
+        ring_buffer_->publish(lo, hi);
+    }
 
     bool tryPublishEvent(IEventTranslator<T>* translator)
     {
-        if (ring_buffer_->hasAvailableCapacity()) {
-            int64_t sequence = ring_buffer_->next();
-            translator->translateTo(sequence, ring_buffer_->get(sequence));
-            ring_buffer_->publish(sequence);
-            return true;
+        int64_t sequence;
+        if (!ring_buffer_->tryNext(sequence)) {
+            return false;
+        }
+
+        translator->translateTo(sequence, ring_buffer_->get(sequence));
+        ring_buffer_->publish(sequence);
+        return true;
+    }
+
+    // Publish a burst of events only if the buffer has capacity for all of
+    // them, without blocking.
+    //
+    // @param translators one translator per event, in publishing order.
+    // @param n number of events to publish, at most the buffer capacity.
+    // @return true if the events were published, false if the buffer is
+    // full.
+    bool tryPublishEvents(IEventTranslator<T>* const* translators,
+                          const int& n)
+    {
+        int64_t hi;
+        if (!ring_buffer_->tryNext(n, hi)) {
+            return false;
+        }
+
+        int64_t lo = hi - n + 1;
+        for (int i = 0; i < n; ++i) {
+            translators[i]->translateTo(lo + i, ring_buffer_->get(lo + i));
+        }
+        ring_buffer_->publish(lo, hi);
+        return true;
+    }
+
+#ifdef has_cplusplus11
+    // Publish an event by calling f(sequence, event, args...) on the claimed
+    // slot. The call is inlined, so no translator object or virtual call is
+    // needed per event.
+    //
+    // @param f callable translating args into the event.
+    // @param args forwarded to f after the sequence and event.
+    template <typename F, typename... Args>
+    typename EnableIfCallable<T, F>::type
+    publishEvent(F&& f, Args&&... args)
+    {
+        int64_t sequence = ring_buffer_->next();
+        f(sequence, ring_buffer_->get(sequence), std::forward<Args>(args)...);
+        ring_buffer_->publish(sequence);
+    }
+
+    // Publish an event by calling f(sequence, event, args...) on the claimed
+    // slot, only if the buffer has capacity, without blocking.
+    //
+    // @param f callable translating args into the event.
+    // @param args forwarded to f after the sequence and event.
+    // @return true if the event was published, false if the buffer is full.
+    template <typename F, typename... Args>
+    typename EnableIfCallable<T, F, bool>::type
+    tryPublishEvent(F&& f, Args&&... args)
+    {
+        int64_t sequence;
+        if (!ring_buffer_->tryNext(sequence)) {
+            return false;
+        }
+
+        f(sequence, ring_buffer_->get(sequence), std::forward<Args>(args)...);
+        ring_buffer_->publish(sequence);
+        return true;
+    }
+
+    // Publish a burst of n events by calling f(sequence, event) on each
+    // claimed slot in order, with one claim, one cursor update and one
+    // wake-up.
+    //
+    // @param f callable translating into each event.
+    // @param n number of events to publish, at most the buffer capacity.
+    template <typename F>
+    typename EnableIfCallable<T, F>::type
+    publishEvents(F&& f, const int& n)
+    {
+        int64_t hi = ring_buffer_->next(n);
+        int64_t lo = hi - n + 1;
+        for (int64_t sequence = lo; sequence <= hi; ++sequence) {
+            f(sequence, ring_buffer_->get(sequence));
         }
+        ring_buffer_->publish(lo, hi);
+    }
 
-        return false;
+    // Publish a burst of n events by calling f(sequence, event) on each
+    // claimed slot in order, only if the buffer has capacity for all of
+    // them, without blocking.
+    //
+    // @param f callable translating into each event.
+    // @param n number of events to publish, at most the buffer capacity.
+    // @return true if the events were published, false if the buffer is
+    // full.
+    template <typename F>
+    typename EnableIfCallable<T, F, bool>::type
+    tryPublishEvents(F&& f, const int& n)
+    {
+        int64_t hi;
+        if (!ring_buffer_->tryNext(n, hi)) {
+            return false;
+        }
+
+        int64_t lo = hi - n + 1;
+        for (int64_t sequence = lo; sequence <= hi; ++sequence) {
+            f(sequence, ring_buffer_->get(sequence));
+        }
+        ring_buffer_->publish(lo, hi);
+        return true;
     }
+#endif
 
     bool hasAvailableCapacity() const 
     {
@@ -41,7 +206,7 @@ public:
     }
 
 private:
-    RingBuffer<T>* ring_buffer_;
+    RingBufferType* ring_buffer_;
 };
 
 }
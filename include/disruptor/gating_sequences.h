@@ -0,0 +1,170 @@
+#ifndef DISRUPTOR_GATING_SEQUENCES_H_
+#define DISRUPTOR_GATING_SEQUENCES_H_
+
+#include <disruptor/atomic_snapshot.h>
+#include <disruptor/sequence.h>
+
+namespace disruptor {
+
+// Number of sequences sharing a cached minimum in {@link GatingSequences}.
+const int GATING_GROUP_SIZE = 8;
+
+// {@link Sequence}s gating a publisher or a consumer, split in groups which
+// each cache a lower bound of the minimum of their sequences.
+//
+// Reading the sequences is what costs, each one is a cache line its
+// consumer keeps writing. As the sequences only move forward, a cached
+// minimum that already reaches the required sequence proves its whole group
+// does without reading any of them. Only the groups cached behind the
+// required sequence are scanned again, starting with the one found lagging
+// last time, and the scan stops at the first group still behind, so a
+// publisher waiting on the slowest consumer only reads its group.
+class GatingSequences
+{
+public:
+    // @param sequences to be tracked.
+    // @param group_size number of sequences sharing a cached minimum.
+    explicit GatingSequences(
+            const DependentSequences& sequences = DependentSequences(),
+            int group_size = GATING_GROUP_SIZE)
+        : sequences_(sequences)
+        , group_size_(group_size)
+        , num_groups_((sequences.size() + group_size - 1) / group_size)
+        , group_minimums_(new Sequence[num_groups_])
+        , lagging_group_(0)
+    {
+        for (size_t i = 0; i < num_groups_; ++i) {
+            group_minimums_[i].set(LONG_MIN, stdext::memory_order_relaxed);
+        }
+    }
+
+    // @return the tracked sequences.
+    const DependentSequences& sequences() const { return sequences_; }
+
+    bool empty() const { return sequences_.empty(); }
+
+    // Get the minimum of the sequences, reading all of them.
+    //
+    // @return the minimum sequence, LONG_MAX if there are none.
+    int64_t getMinimumSequence() const
+    {
+        int64_t minimum = LONG_MAX;
+        for (size_t group = 0; group < num_groups_; ++group) {
+            int64_t group_minimum = refresh(group);
+            minimum = minimum < group_minimum ? minimum : group_minimum;
+        }
+        return minimum;
+    }
+
+    // Get a lower bound of the minimum of the sequences, reading only the
+    // groups whose cached minimum is behind required.
+    //
+    // @param required sequence all the sequences should have reached, e.g.
+    // the wrap point of a publisher.
+    // @return a lower bound of the minimum sequence, which is below required
+    // only if a sequence was read below it, LONG_MAX if there are none.
+    int64_t getMinimumSequence(const int64_t& required) const
+    {
+        int64_t minimum = LONG_MAX;
+        size_t first = lagging_group_.load(stdext::memory_order_relaxed);
+        for (size_t i = 0; i < num_groups_; ++i) {
+            size_t group = first + i < num_groups_ ?
+                first + i : first + i - num_groups_;
+            int64_t group_minimum =
+                group_minimums_[group].get(stdext::memory_order_relaxed);
+            if (group_minimum < required) {
+                group_minimum = refresh(group);
+                if (group_minimum < required) {
+                    lagging_group_.store(group, stdext::memory_order_relaxed);
+                    return group_minimum;
+                }
+            }
+            minimum = minimum < group_minimum ? minimum : group_minimum;
+        }
+        return minimum;
+    }
+
+private:
+    GatingSequences(const GatingSequences&);
+    GatingSequences& operator= (GatingSequences);
+
+    // Read the sequences of a group and cache their minimum. Racing
+    // refreshes may store an older minimum, which is still a lower bound.
+    int64_t refresh(const size_t& group) const
+    {
+        size_t begin = group * group_size_;
+        size_t end = begin + group_size_ < sequences_.size() ?
+            begin + group_size_ : sequences_.size();
+        int64_t minimum = LONG_MAX;
+        for (size_t i = begin; i < end; ++i) {
+            int64_t sequence = sequences_[i]->get();
+            minimum = minimum < sequence ? minimum : sequence;
+        }
+        group_minimums_[group].set(minimum, stdext::memory_order_relaxed);
+        return minimum;
+    }
+
+    const DependentSequences sequences_;
+    const size_t group_size_;
+    const size_t num_groups_;
+#ifdef has_cplusplus11
+    std::unique_ptr<Sequence[]> group_minimums_;
+#else
+    boost::scoped_array<Sequence> group_minimums_;
+#endif
+    mutable stdext::atomic<size_t> lagging_group_;
+};
+
+// {@link GatingSequences} replaced while publishers read them, the gating
+// sequences of a {@link Sequencer}.
+//
+// A read is one pointer load plus the scan of {@link GatingSequences}, on
+// the wrap checks as in the loops of the publishers waiting on a full
+// buffer. Replaced snapshots are retired until {@link #reclaim()}, see
+// {@link AtomicSnapshot}.
+class AtomicGatingSequences
+{
+public:
+    // @param sequences to be tracked.
+    explicit AtomicGatingSequences(
+            const DependentSequences& sequences = DependentSequences())
+        : snapshot_(new GatingSequences(sequences))
+    {
+    }
+
+    // @return the current snapshot, valid until the next reclaim.
+    const GatingSequences* load() const { return snapshot_.load(); }
+
+    // Replace the snapshot, writers must be serialised by the caller.
+    //
+    // @param sequences to be tracked from now on.
+    void store(const DependentSequences& sequences)
+    {
+        snapshot_.store(new GatingSequences(sequences));
+    }
+
+    // Free the replaced snapshots, see {@link AtomicSnapshot#reclaim()}.
+    void reclaim() { snapshot_.reclaim(); }
+
+    // @see GatingSequences#getMinimumSequence()
+    int64_t getMinimumSequence() const
+    {
+        return load()->getMinimumSequence();
+    }
+
+    // @see GatingSequences#getMinimumSequence(const int64_t&)
+    int64_t getMinimumSequence(const int64_t& required) const
+    {
+        return load()->getMinimumSequence(required);
+    }
+
+private:
+    AtomicGatingSequences(const AtomicGatingSequences&);
+    AtomicGatingSequences& operator= (AtomicGatingSequences);
+
+    AtomicSnapshot<GatingSequences> snapshot_;
+};
+
+}
+
+#endif
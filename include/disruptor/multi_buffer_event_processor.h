@@ -0,0 +1,238 @@
+#ifndef DISRUPTOR_MULTI_BUFFER_EVENT_PROCESSOR_H_
+#define DISRUPTOR_MULTI_BUFFER_EVENT_PROCESSOR_H_
+
+#include <vector>
+
+#include <disruptor/ring_buffer.h>
+
+
+namespace disruptor {
+
+
+// Consumes several {@link RingBuffer}s from a single thread, delegating the
+// events of all of them to one {@link EventHandler}.
+//
+// Each {@link RingBuffer} has its own {@link SequenceBarrier} and
+// {@link Sequence}. The buffers are polled round-robin, at most
+// max_batch_size events per buffer in turn so
+// that a busy buffer cannot starve the others. A round resumes after the
+// buffer whose handler threw, so a failing buffer cannot starve the ones
+// after it either.
+//
+// When whole rounds find nothing to process, the thread yields for a few
+// rounds and then parks on the wait strategy of each buffer in turn, for at
+// most max_idle_time, so an event published on another buffer is picked up
+// within max_idle_time. A failed wait is reported to the exception handler
+// with a NULL event and consumes nothing.
+//
+// @param <T> event implementation storing the data for sharing during
+// exchange or parallel coordination of an event.
+// @param <RingBufferType> the {@link RingBuffer} instances consumed from.
+template <typename T, typename RingBufferType = RingBuffer<T> >
+class MultiBufferBatchEventProcessor
+{
+public:
+    typedef typename RingBufferType::barrier_type barrier_type;
+
+    // Construct a processor consuming ring_buffers[i] through barriers[i].
+    //
+    // @param ring_buffers to consume from.
+    // @param barriers one per {@link RingBuffer}, in the same order.
+    // @param event_handler to which the events of all buffers are dispatched.
+    // @param exception_handler to be called back when an error occurs.
+    // @param max_batch_size of events processed from a buffer in turn.
+    // @param max_idle_time spent parked on a single buffer once idle.
+    //
+    // @throws std::invalid_argument if the number of barriers differs from
+    // the number of {@link RingBuffer}s, there is no {@link RingBuffer} or
+    // max_batch_size < 1.
+    MultiBufferBatchEventProcessor(
+            const std::vector<RingBufferType*>& ring_buffers,
+            const std::vector<stdext::shared_ptr<barrier_type> >& barriers,
+            IEventHandler<T>* event_handler,
+            IExceptionHandler<T>* exception_handler,
+            const int& max_batch_size,
+            const stdext::chrono::microseconds& max_idle_time =
+                stdext::chrono::microseconds(1000))
+        : running_(false)
+        , ring_buffers_(ring_buffers)
+        , sequence_barriers_(barriers)
+        , sequences_(new Sequence[ring_buffers.size()])
+        , event_handler_(event_handler)
+        , exception_handler_(exception_handler)
+        , max_batch_size_(max_batch_size)
+        , max_idle_time_(max_idle_time)
+    {
+        if (ring_buffers.size() != barriers.size()) {
+            throw std::invalid_argument(
+                    "Should have as many barriers as ring buffers");
+        }
+        if (ring_buffers.empty()) {
+            throw std::invalid_argument("Should have at least one ring buffer");
+        }
+        if (max_batch_size < 1) {
+            throw std::invalid_argument("max_batch_size must be > 0");
+        }
+    }
+
+    // Get the sequences of the processor, sequence i has to be set as a
+    // gating sequence of the i-th {@link RingBuffer}.
+    //
+    // @return one {@link Sequence} per {@link RingBuffer}.
+    DependentSequences getSequences()
+    {
+        DependentSequences sequences;
+        for (size_t i = 0; i < ring_buffers_.size(); ++i) {
+            sequences.push_back(&sequences_[i]);
+        }
+        return sequences;
+    }
+
+    void halt();
+
+    void operator() () { run(); }
+
+protected:
+    void run();
+
+private:
+    // Number of idle rounds the thread yields before parking.
+    static const int MAX_IDLE_YIELDS = 100;
+
+    MultiBufferBatchEventProcessor(const MultiBufferBatchEventProcessor& m);
+    MultiBufferBatchEventProcessor& operator= (
+            MultiBufferBatchEventProcessor m);
+
+    stdext::atomic<bool>                          running_;
+    std::vector<RingBufferType*>                  ring_buffers_;
+    std::vector<stdext::shared_ptr<barrier_type> > sequence_barriers_;
+#ifdef has_cplusplus11
+    std::unique_ptr<Sequence[]>                   sequences_;
+#else
+    boost::scoped_array<Sequence>                 sequences_;
+#endif
+    IEventHandler<T>*                             event_handler_;
+    IExceptionHandler<T>*                         exception_handler_;
+    const int                                     max_batch_size_;
+    const stdext::chrono::microseconds            max_idle_time_;
+};
+
+
+//
+// implementation
+//
+
+template <typename T, typename RingBufferType>
+void MultiBufferBatchEventProcessor<T, RingBufferType>::halt()
+{
+    running_.store(false);
+    for (size_t i = 0; i < sequence_barriers_.size(); ++i) {
+        sequence_barriers_[i]->alert();
+    }
+}
+
+
+template <typename T, typename RingBufferType>
+void MultiBufferBatchEventProcessor<T, RingBufferType>::run()
+{
+    bool expected = false;
+    if (!running_.compare_exchange_strong(expected, true)) {
+        throw std::runtime_error("Thread is already running");
+    }
+
+    event_handler_->onStart();
+
+    const size_t num_buffers = ring_buffers_.size();
+    size_t first = 0;
+    int idle_rounds = 0;
+    size_t parked = 0;
+
+    while (true) {
+        int64_t processed = 0;
+        try {
+            for (size_t n = 0; n < num_buffers; ++n) {
+                const size_t i = (first + n) % num_buffers;
+                barrier_type* barrier = sequence_barriers_[i].get();
+                barrier->barrier_type::checkAlert();
+
+                int64_t next_sequence = sequences_[i].get() + 1L;
+                int64_t available_sequence =
+                    barrier->barrier_type::getAvailableSequence(next_sequence);
+                if (available_sequence - next_sequence >= max_batch_size_) {
+                    available_sequence = next_sequence + max_batch_size_ - 1;
+                }
+
+                int64_t batch_size = available_sequence - next_sequence + 1;
+                T* event = NULL;
+                try {
+                    while (next_sequence <= available_sequence) {
+                        event = ring_buffers_[i]->get(next_sequence);
+                        event_handler_->onEvent(next_sequence,
+                                batch_size,
+                                next_sequence == available_sequence, event);
+                        next_sequence++;
+                    }
+                }
+                catch(const std::exception& e) {
+                    if (exception_handler_) {
+                        exception_handler_->handle(e, next_sequence, event);
+                    }
+                    // the failing event is consumed, and the next round
+                    // resumes after its buffer
+                    sequences_[i].set(next_sequence);
+                    barrier->barrier_type::signalProducers();
+                    first = (i + 1) % num_buffers;
+                    processed = 1;
+                    break;
+                }
+
+                if (batch_size > 0) {
+                    sequences_[i].set(available_sequence);
+                    barrier->barrier_type::signalProducers();
+                    processed += batch_size;
+                }
+            }
+
+            if (processed == 0) {
+                if (idle_rounds < MAX_IDLE_YIELDS) {
+                    ++idle_rounds;
+                    stdext::this_thread::yield();
+                }
+                else {
+                    // park on the buffers in turn, any of them publishing
+                    // wakes the thread up within max_idle_time
+                    const size_t buffer = parked;
+                    const int64_t awaited = sequences_[buffer].get() + 1L;
+                    parked = (parked + 1) % num_buffers;
+                    try {
+                        sequence_barriers_[buffer]->barrier_type::waitFor(
+                                awaited, max_idle_time_);
+                    }
+                    catch(const AlertException& e) {
+                        throw;
+                    }
+                    catch(const std::exception& e) {
+                        // a failed wait consumes nothing, the next round
+                        // polls every buffer again
+                        if (exception_handler_) {
+                            exception_handler_->handle(e, awaited, NULL);
+                        }
+                    }
+                }
+            }
+            else {
+                idle_rounds = 0;
+            }
+        }
+        catch(const AlertException& e) {
+            break;
+        }
+    }
+
+    event_handler_->onShutdown();
+    running_.store(false);
+}
+
+}
+
+#endif
@@ -0,0 +1,313 @@
+#ifndef DISRUPTOR_PRODUCER_WAIT_STRATEGY_H_
+#define DISRUPTOR_PRODUCER_WAIT_STRATEGY_H_
+
+#ifdef __linux__
+#include <errno.h>
+#include <limits.h>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <disruptor/clock.h>
+#include <disruptor/interface.h>
+
+namespace disruptor {
+
+// Strategy options for publishers waiting on a full {@link RingBuffer}.
+enum ProducerWaitStrategyOption {
+    // Spin on the gating sequences, lowest latency but ties up a CPU.
+    kBusySpinProducerWaitStrategy,
+    // Spin with CPU pause hints through a {@link SpinBackoff}, leaving most
+    // of the core to its SMT sibling.
+    kPausingProducerWaitStrategy,
+    // Yield in a loop, a good compromise when consumers keep up. The default
+    // of the single threaded claim strategy.
+    kYieldingProducerWaitStrategy,
+    // Spin 1000 times then sleep for the kSleep time between checks.
+    kSleepingProducerWaitStrategy,
+#ifdef __linux__
+    // Spin for the kSpin time then park on a futex, woken up by the
+    // {@link EventProcessor}s as they move their sequences. Linux only.
+    kFutexProducerWaitStrategy
+#endif
+};
+
+// What a publisher waiting on a full {@link RingBuffer} reads: the minimum
+// of the gating sequences, which has to reach the wrap point.
+class GatingSequencesGate
+{
+public:
+    explicit GatingSequencesGate(const AtomicGatingSequences& gating_sequences)
+        : gating_sequences_(gating_sequences)
+    {
+    }
+
+    int64_t get(const int64_t& wrap_point) const
+    {
+        return gating_sequences_.getMinimumSequence(wrap_point);
+    }
+
+private:
+    const AtomicGatingSequences& gating_sequences_;
+};
+
+// What a publisher with too many pending publications reads: the cursor,
+// which has to reach the oldest sequence it may leave pending.
+class CursorGate
+{
+public:
+    explicit CursorGate(const Sequence& cursor) : cursor_(cursor) {}
+
+    int64_t get(const int64_t& sequence) const { return cursor_.get(); }
+
+private:
+    const Sequence& cursor_;
+};
+
+// Base of the producer wait strategies, forwarding both waits of
+// {@link IProducerWaitStrategy} to the waitUntil(sequence, gate) template of
+// the strategy.
+template <typename Strategy>
+class BasicProducerWaitStrategy : public IProducerWaitStrategy
+{
+public:
+    virtual int64_t waitFor(const int64_t& wrap_point,
+                            const AtomicGatingSequences& gating_sequences)
+    {
+        return static_cast<Strategy*>(this)->waitUntil(wrap_point,
+                GatingSequencesGate(gating_sequences));
+    }
+
+    virtual int64_t waitFor(const int64_t& sequence, const Sequence& cursor)
+    {
+        return static_cast<Strategy*>(this)->waitUntil(sequence,
+                CursorGate(cursor));
+    }
+};
+
+// Busy spin strategy for publishers waiting on a full {@link RingBuffer}.
+class BusySpinProducerWaitStrategy
+    : public BasicProducerWaitStrategy<BusySpinProducerWaitStrategy>
+{
+public:
+    BusySpinProducerWaitStrategy() {}
+
+    // @return gate.get(sequence) once it is at least sequence.
+    template <typename Gate>
+    int64_t waitUntil(const int64_t& sequence, const Gate& gate)
+    {
+        int64_t min_sequence;
+        while (sequence > (min_sequence = gate.get(sequence))) {
+        }
+        return min_sequence;
+    }
+
+    virtual void signalAllWhenBlocking() {}
+
+    virtual bool isBlocking() const { return false; }
+};
+
+// Variation of the {@link BusySpinProducerWaitStrategy} issuing CPU pause
+// hints between checks.
+class PausingProducerWaitStrategy
+    : public BasicProducerWaitStrategy<PausingProducerWaitStrategy>
+{
+public:
+    PausingProducerWaitStrategy() {}
+
+    template <typename Gate>
+    int64_t waitUntil(const int64_t& sequence, const Gate& gate)
+    {
+        int64_t min_sequence;
+        SpinBackoff backoff;
+        while (sequence > (min_sequence = gate.get(sequence))) {
+            backoff.pause();
+        }
+        return min_sequence;
+    }
+
+    virtual void signalAllWhenBlocking() {}
+
+    virtual bool isBlocking() const { return false; }
+};
+
+// Yielding strategy for publishers waiting on a full {@link RingBuffer}.
+class YieldingProducerWaitStrategy
+    : public BasicProducerWaitStrategy<YieldingProducerWaitStrategy>
+{
+public:
+    YieldingProducerWaitStrategy() {}
+
+    template <typename Gate>
+    int64_t waitUntil(const int64_t& sequence, const Gate& gate)
+    {
+        int64_t min_sequence;
+        while (sequence > (min_sequence = gate.get(sequence))) {
+            stdext::this_thread::yield();
+        }
+        return min_sequence;
+    }
+
+    virtual void signalAllWhenBlocking() {}
+
+    virtual bool isBlocking() const { return false; }
+};
+
+// Sleeping strategy for publishers waiting on a full {@link RingBuffer},
+// spins retries times then sleeps for sleep_time between checks. With a 1ms
+// sleep, this is the default of the multi threaded claim strategies.
+class SleepingProducerWaitStrategy
+    : public BasicProducerWaitStrategy<SleepingProducerWaitStrategy>
+{
+public:
+    SleepingProducerWaitStrategy(
+            const stdext::chrono::microseconds& sleep_time)
+        : sleep_time_(sleep_time)
+    {
+    }
+
+    template <typename Gate>
+    int64_t waitUntil(const int64_t& sequence, const Gate& gate)
+    {
+        int counter = retries;
+        int64_t min_sequence;
+        while (sequence > (min_sequence = gate.get(sequence))) {
+            if (counter > 0) {
+                counter--;
+            }
+            else {
+                stdext::this_thread::sleep(sleep_time_);
+            }
+        }
+        return min_sequence;
+    }
+
+    virtual void signalAllWhenBlocking() {}
+
+    virtual bool isBlocking() const { return false; }
+
+    static const int retries = 1000;
+
+private:
+    const stdext::chrono::microseconds sleep_time_;
+};
+
+#ifdef __linux__
+// Spin then park strategy for publishers waiting on a full
+// {@link RingBuffer}.
+//
+// The publisher spins for spin_time, then parks on a futex word bumped by
+// the {@link EventProcessor}s, or by the publishers moving the cursor,
+// through {@link #signalAllWhenBlocking()} only while a publisher is parked.
+// A parked publisher also rechecks every kMaxParkMicros, for consumers that
+// do not signal.
+class FutexProducerWaitStrategy
+    : public BasicProducerWaitStrategy<FutexProducerWaitStrategy>
+{
+public:
+    static const int64_t kMaxParkMicros = 1000;
+
+    FutexProducerWaitStrategy(const stdext::chrono::microseconds& spin_time)
+        : spin_time_(spin_time)
+        , futex_(0)
+        , waiters_(0)
+    {
+    }
+
+    template <typename Gate>
+    int64_t waitUntil(const int64_t& sequence, const Gate& gate)
+    {
+        int64_t min_sequence;
+        // up to MAX_SPIN_PAUSES pauses cost more than a clock read
+        Deadline spin_deadline(spin_time_, 1);
+        SpinBackoff backoff;
+        while (sequence > (min_sequence = gate.get(sequence))) {
+            if (spin_deadline.expired()) {
+                break;
+            }
+            backoff.pause();
+        }
+
+        if (sequence > min_sequence) {
+            waiters_.fetch_add(1);
+            stdext::atomic_thread_fence(stdext::memory_order_seq_cst);
+            while (true) {
+                // read the word before the gate, a signal in between
+                // changes the word and the futex wait returns at once
+                int32_t word = futex_.load(stdext::memory_order_acquire);
+                if (sequence <= (min_sequence = gate.get(sequence))) {
+                    break;
+                }
+                park(word);
+            }
+            waiters_.fetch_sub(1);
+        }
+
+        return min_sequence;
+    }
+
+    virtual void signalAllWhenBlocking()
+    {
+        // pairs with the fence of the waiters so either the consumer sees
+        // the waiter, or the waiter sees the moved sequence
+        stdext::atomic_thread_fence(stdext::memory_order_seq_cst);
+        if (waiters_.load(stdext::memory_order_relaxed) != 0) {
+            futex_.fetch_add(1, stdext::memory_order_release);
+            syscall(SYS_futex, futexWord(), FUTEX_WAKE_PRIVATE, INT_MAX,
+                    NULL, NULL, 0);
+        }
+    }
+
+    virtual bool isBlocking() const { return true; }
+
+private:
+    void park(int32_t word)
+    {
+        struct timespec timeout;
+        timeout.tv_sec = 0;
+        timeout.tv_nsec = kMaxParkMicros * 1000L;
+        syscall(SYS_futex, futexWord(), FUTEX_WAIT_PRIVATE, word,
+                &timeout, NULL, 0);
+    }
+
+    int32_t* futexWord()
+    {
+        return reinterpret_cast<int32_t*>(&futex_);
+    }
+
+    const stdext::chrono::microseconds spin_time_;
+    stdext::atomic<int32_t> futex_;
+    stdext::atomic<int> waiters_;
+};
+#endif
+
+inline ProducerWaitStrategyPtr createProducerWaitStrategy(
+        ProducerWaitStrategyOption option,
+        const TimeConfig& timeConfig)
+{
+    switch (option) {
+        case kBusySpinProducerWaitStrategy:
+            return stdext::make_shared<BusySpinProducerWaitStrategy>();
+        case kPausingProducerWaitStrategy:
+            return stdext::make_shared<PausingProducerWaitStrategy>();
+        case kYieldingProducerWaitStrategy:
+            return stdext::make_shared<YieldingProducerWaitStrategy>();
+        case kSleepingProducerWaitStrategy:
+            return stdext::make_shared<SleepingProducerWaitStrategy>(
+                    getTimeConfig(timeConfig, kSleep,
+                        stdext::chrono::milliseconds(1)));
+#ifdef __linux__
+        case kFutexProducerWaitStrategy:
+            return stdext::make_shared<FutexProducerWaitStrategy>(
+                    getTimeConfig(timeConfig, kSpin,
+                        stdext::chrono::microseconds(10)));
+#endif
+        default:
+            return ProducerWaitStrategyPtr();
+    }
+}
+
+}
+
+#endif
@@ -6,15 +6,61 @@
 
 namespace disruptor {
 
+// Hint the CPU to fetch the cache lines of an event ahead of a read, e.g.
+// the slots a processor is about to handle, which were last written by a
+// publisher on another core. Only a hint: it neither faults nor blocks.
+//
+// @param event to be read soon.
+template <typename T>
+inline void prefetchEvent(const T* event)
+{
+    const uintptr_t end = reinterpret_cast<uintptr_t>(event) + sizeof(T);
+    uintptr_t line = reinterpret_cast<uintptr_t>(event) &
+        ~static_cast<uintptr_t>(CACHE_LINE_SIZE_IN_BYTES - 1);
+    for ( ; line < end; line += CACHE_LINE_SIZE_IN_BYTES) {
+        __builtin_prefetch(reinterpret_cast<const void*>(line), 0, 3);
+    }
+}
+
 // Ring based store of reusable entries containing the data representing an
 // event beign exchanged between publisher and {@link EventProcessor}s.
 //
 // @param <T> implementation storing the data for sharing during exchange
 // or parallel coordination of an event.
-template<typename T>
-class RingBuffer : public Sequencer
+// @param <ClaimStrategy> policy for publishers claiming entries, selected
+// from a {@link ClaimStrategyOption} at run time by default.
+// @param <WaitStrategy> policy for processors waiting on entries, selected
+// from a {@link WaitStrategyOption} at run time by default.
+template<typename T,
+         typename ClaimStrategy = RuntimeClaimStrategy,
+         typename WaitStrategy = RuntimeWaitStrategy>
+class RingBuffer : public BasicSequencer<ClaimStrategy, WaitStrategy>
 {
 public:
+    typedef BasicSequencer<ClaimStrategy, WaitStrategy> sequencer_type;
+
+    // Construct a RingBuffer with compile time strategies.
+    //
+    // @param event_factory to instance new entries for filling the RingBuffer.
+    // @param buffer_size of the RingBuffer, will be rounded up to a power
+    // of 2.
+    RingBuffer(IEventFactory<T>* event_factory, int buffer_size)
+        : sequencer_type(buffer_size)
+        , mask_(this->capacity() - 1)
+        , events_(new T[this->capacity()])
+    {
+        if (event_factory) {
+            this->fill(event_factory);
+        }
+    }
+
+    explicit RingBuffer(int buffer_size)
+        : sequencer_type(buffer_size)
+        , mask_(this->capacity() - 1)
+        , events_(new T[this->capacity()])
+    {
+    }
+
     // Construct a RingBuffer with the full option set.
     //
     // @param event_factory to instance new entries for filling the RingBuffer.
@@ -29,10 +75,10 @@ public:
                ClaimStrategyOption claim_strategy_option,
                WaitStrategyOption wait_strategy_option,
                const TimeConfig& timeConfig = TimeConfig())
-        : Sequencer(buffer_size,
-                    claim_strategy_option,
-                    wait_strategy_option,
-                    timeConfig)
+        : sequencer_type(buffer_size,
+                         claim_strategy_option,
+                         wait_strategy_option,
+                         timeConfig)
         , mask_(buffer_size - 1)
         , events_(new T[buffer_size])
     {
@@ -45,13 +91,43 @@ public:
                ClaimStrategyOption claim_strategy_option,
                WaitStrategyOption wait_strategy_option,
                const TimeConfig& timeConfig) 
-        : Sequencer(buffer_size,
-                    claim_strategy_option,
-                    wait_strategy_option,
-                    timeConfig)
+        : sequencer_type(buffer_size,
+                         claim_strategy_option,
+                         wait_strategy_option,
+                         timeConfig)
+        , mask_(buffer_size - 1)
+        , events_(new T[buffer_size])
+    {
+    }
+
+    // Construct a RingBuffer with the full option set, including the
+    // strategy of the publishers waiting on a full ring.
+    //
+    // @param event_factory to instance new entries for filling the RingBuffer.
+    // @param buffer_size of the RingBuffer, must be a power of 2.
+    // @param claim_strategy_option threading strategy for publishers claiming
+    // entries in the ring.
+    // @param wait_strategy_option waiting strategy employed by
+    // processors_to_track waiting in entries becoming available.
+    // @param producer_wait_strategy_option waiting strategy employed by
+    // publishers when the ring is full.
+    RingBuffer(IEventFactory<T>* event_factory,
+               int buffer_size,
+               ClaimStrategyOption claim_strategy_option,
+               WaitStrategyOption wait_strategy_option,
+               ProducerWaitStrategyOption producer_wait_strategy_option,
+               const TimeConfig& timeConfig = TimeConfig())
+        : sequencer_type(buffer_size,
+                         claim_strategy_option,
+                         wait_strategy_option,
+                         producer_wait_strategy_option,
+                         timeConfig)
         , mask_(buffer_size - 1)
         , events_(new T[buffer_size])
     {
+        if (event_factory) {
+            this->fill(event_factory);
+        }
     }
 
     ~RingBuffer()
@@ -67,10 +143,19 @@ public:
         return &events_[sequence & mask_];
     }
 
+    // Prefetch the event for a given sequence, wrapping around the
+    // RingBuffer like {@link #get()}.
+    //
+    // @param sequence of an event to be read soon.
+    void prefetch(const int64_t& sequence) const
+    {
+        prefetchEvent(&events_[sequence & mask_]);
+    }
+
 private:
     void fill( IEventFactory<T>* factory)
     {
-        for (int i = 0; i < capacity(); ++i) {
+        for (int i = 0; i < this->capacity(); ++i) {
             events_[i] = *(factory->newInstance());
         }
     }
@@ -85,6 +170,105 @@ private:
 
 };
 
+// {@link RingBuffer} with a capacity fixed at compile time.
+//
+// The index mask is a constant and the entries are embedded in the object,
+// so get() compiles to an and with an immediate and no pointer load. The
+// concrete claim strategies are given the capacity as a template argument
+// too, so their wrap checks subtract a constant. With a capacity of many
+// large events, allocate the buffer on the heap.
+//
+// @param <T> implementation storing the data for sharing during exchange
+// or parallel coordination of an event.
+// @param <N> capacity of the buffer, must be a power of 2.
+// @param <ClaimStrategy> policy for publishers claiming entries.
+// @param <WaitStrategy> policy for processors waiting on entries.
+template<typename T,
+         int N,
+         typename ClaimStrategy = RuntimeClaimStrategy,
+         typename WaitStrategy = RuntimeWaitStrategy>
+class FixedRingBuffer : public BasicSequencer<
+    typename FixedCapacityClaimStrategy<ClaimStrategy, N>::type, WaitStrategy>
+{
+#ifdef has_cplusplus11
+    static_assert(N > 0 && (N & (N - 1)) == 0, "N must be a power of 2");
+#else
+    typedef char N_must_be_a_power_of_2[(N > 0 && (N & (N - 1)) == 0) ? 1 : -1];
+#endif
+
+public:
+    typedef BasicSequencer<
+        typename FixedCapacityClaimStrategy<ClaimStrategy, N>::type,
+        WaitStrategy> sequencer_type;
+
+    static const int CAPACITY = N;
+    static const int64_t INDEX_MASK = N - 1;
+
+    // Construct a FixedRingBuffer with compile time strategies, or with
+    // the default ones of {@link RuntimeClaimStrategy} and
+    // {@link RuntimeWaitStrategy}.
+    //
+    // @param event_factory to instance new entries for filling the
+    // FixedRingBuffer.
+    explicit FixedRingBuffer(IEventFactory<T>* event_factory = NULL)
+        : sequencer_type(N)
+    {
+        if (event_factory) {
+            this->fill(event_factory);
+        }
+    }
+
+    // Construct a FixedRingBuffer with the full option set.
+    //
+    // @param event_factory to instance new entries for filling the
+    // FixedRingBuffer.
+    // @param claim_strategy_option threading strategy for publishers
+    // claiming entries in the ring.
+    // @param wait_strategy_option waiting strategy employed by
+    // processors_to_track waiting in entries becoming available.
+    FixedRingBuffer(IEventFactory<T>* event_factory,
+                    ClaimStrategyOption claim_strategy_option,
+                    WaitStrategyOption wait_strategy_option,
+                    const TimeConfig& timeConfig = TimeConfig())
+        : sequencer_type(N,
+                         claim_strategy_option,
+                         wait_strategy_option,
+                         timeConfig)
+    {
+        if (event_factory) {
+            this->fill(event_factory);
+        }
+    }
+
+    // Get the event for a given sequence in the FixedRingBuffer.
+    //
+    // @param sequence for the event
+    // @return event pointer at the specified sequence position.
+    T* get(const int64_t& sequence)
+    {
+        return &events_[sequence & INDEX_MASK];
+    }
+
+    // Prefetch the event for a given sequence, wrapping around the
+    // FixedRingBuffer like {@link #get()}.
+    //
+    // @param sequence of an event to be read soon.
+    void prefetch(const int64_t& sequence) const
+    {
+        prefetchEvent(&events_[sequence & INDEX_MASK]);
+    }
+
+private:
+    void fill(IEventFactory<T>* factory)
+    {
+        for (int i = 0; i < N; ++i) {
+            events_[i] = *(factory->newInstance());
+        }
+    }
+
+    T events_[N];
+};
+
 }
 
 #endif
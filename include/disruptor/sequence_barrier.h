@@ -6,25 +6,42 @@
 
 #include <disruptor/exceptions.h>
 #include <disruptor/interface.h>
+#include <disruptor/claim_strategy.h>
+#include <disruptor/wait_strategy.h>
 
 namespace disruptor {
 
-class ProcessingSequenceBarrier : public ISequenceBarrier
+// {@link SequenceBarrier} handed out by a {@link BasicSequencer}, calling
+// its claim and wait policies directly.
+//
+// The policy calls are qualified with the policy type so they are bound at
+// compile time and can be inlined, even though the concrete strategies
+// implement the virtual interfaces.
+//
+// The dependent sequences are held as {@link GatingSequences}: a consumer
+// whose next sequence is already covered by the cached group minimums does
+// not read the other consumers' sequences nor call the wait strategy.
+template <typename ClaimStrategy, typename WaitStrategy>
+class BasicSequenceBarrier : public ISequenceBarrier
 {
     public:
-        ProcessingSequenceBarrier(IWaitStrategy* wait_strategy,
+        BasicSequenceBarrier(WaitStrategy* wait_strategy,
+                ClaimStrategy* claim_strategy,
                 Sequence* sequence,
                 const DependentSequences& dependent_sequences)
             : wait_strategy_(wait_strategy)
+            , claim_strategy_(claim_strategy)
             , cursor_sequence_(sequence)
-            , dependent_sequences_(dependent_sequences)
+            , dependents_(dependent_sequences)
             , alerted_(false)
         {
         }
 
-        ProcessingSequenceBarrier(IWaitStrategy* wait_strategy,
+        BasicSequenceBarrier(WaitStrategy* wait_strategy,
+                ClaimStrategy* claim_strategy,
                 Sequence* sequence)
             : wait_strategy_(wait_strategy)
+            , claim_strategy_(claim_strategy)
             , cursor_sequence_(sequence)
             , alerted_(false)
         {
@@ -32,15 +49,47 @@ class ProcessingSequenceBarrier : public ISequenceBarrier
 
         virtual int64_t waitFor(const int64_t& sequence)
         {
-            return wait_strategy_->waitFor(sequence,
-                    *cursor_sequence_, dependent_sequences_, *this);
+            int64_t available_sequence = cachedDependentSequence(sequence);
+            if (available_sequence < sequence) {
+                available_sequence = wait_strategy_->WaitStrategy::waitFor(
+                        sequence, *cursor_sequence_, dependents_.sequences(),
+                        *this);
+            }
+            return getHighestPublishedSequence(sequence, available_sequence);
         }
 
         virtual int64_t waitFor(const int64_t& sequence,
                                 const stdext::chrono::microseconds& timeout)
         {
-            return wait_strategy_->waitFor(sequence,
-                    *cursor_sequence_, dependent_sequences_, *this, timeout);
+            int64_t available_sequence = cachedDependentSequence(sequence);
+            if (available_sequence < sequence) {
+                available_sequence = wait_strategy_->WaitStrategy::waitFor(
+                        sequence, *cursor_sequence_, dependents_.sequences(),
+                        *this, timeout);
+            }
+            return getHighestPublishedSequence(sequence, available_sequence);
+        }
+
+        // Get the highest sequence available for consumption without waiting,
+        // for consumers that poll rather than park on the wait strategy.
+        //
+        // @param sequence the next sequence to be consumed.
+        // @return the sequence up to which is available, which is
+        // sequence - 1 if nothing new has been published.
+        int64_t getAvailableSequence(const int64_t& sequence) const
+        {
+            int64_t available_sequence = dependents_.empty() ?
+                cursor_sequence_->get() :
+                dependents_.getMinimumSequence(sequence);
+            return getHighestPublishedSequence(sequence, available_sequence);
+        }
+
+        // Wake the publishers parked on a full buffer, to be called by the
+        // consumer of this barrier after it moved its sequence. Only costs a
+        // load and a branch unless the producer wait strategy can block.
+        void signalProducers()
+        {
+            claim_strategy_->ClaimStrategy::signalProducers();
         }
 
         virtual int64_t getCursor() const
@@ -71,12 +120,39 @@ class ProcessingSequenceBarrier : public ISequenceBarrier
         }
 
     private:
-        IWaitStrategy*       wait_strategy_;
+        // @return a lower bound of the dependent sequences from the cached
+        // group minimums, which is below sequence when there are no
+        // dependents or one of them is behind.
+        int64_t cachedDependentSequence(const int64_t& sequence) const
+        {
+            if (dependents_.empty()) {
+                return INITIAL_CURSOR_VALUE;
+            }
+            return dependents_.getMinimumSequence(sequence);
+        }
+
+        int64_t getHighestPublishedSequence(const int64_t& sequence,
+                const int64_t& available_sequence) const
+        {
+            if (available_sequence < sequence) {
+                return available_sequence;
+            }
+
+            return claim_strategy_->ClaimStrategy::getHighestPublishedSequence(
+                    sequence, available_sequence);
+        }
+
+        WaitStrategy*        wait_strategy_;
+        ClaimStrategy*       claim_strategy_;
         Sequence*            cursor_sequence_;
-        DependentSequences   dependent_sequences_;
+        GatingSequences      dependents_;
         stdext::atomic<bool> alerted_;
 };
 
+// Barrier of the option based {@link Sequencer}.
+typedef BasicSequenceBarrier<RuntimeClaimStrategy, RuntimeWaitStrategy>
+    ProcessingSequenceBarrier;
+
 }
 
 #endif
@@ -1,6 +1,12 @@
 #ifndef DISRUPTOR_SEQUENCER_H_
 #define DISRUPTOR_SEQUENCER_H_
 
+#include <algorithm>
+#include <stdexcept>
+#ifdef has_cplusplus11
+#include <mutex>
+#endif
+
 #include <disruptor/interface.h>
 #include <disruptor/claim_strategy.h>
 #include <disruptor/wait_strategy.h>
@@ -10,25 +16,72 @@ namespace disruptor {
 
 // Coordinator for claiming sequences for access to a data structures while
 // tracking dependent {@link Sequence}s
-class Sequencer
+//
+// The claim and wait strategies are policies held by value, so when concrete
+// strategies such as {@link SingleThreadedStrategy} and
+// {@link BusySpinStrategy} are given the whole claim, publish and wait path
+// is bound at compile time and a no-op signalAllWhenBlocking disappears.
+// {@link Sequencer} is the instance built from run time options.
+//
+// @param <ClaimStrategy> for those claiming sequences.
+// @param <WaitStrategy> for those waiting on sequences.
+template <typename ClaimStrategy, typename WaitStrategy>
+class BasicSequencer
 {
 public:
-    // Construct a Sequencer with the selected strategies.
+    typedef BasicSequenceBarrier<ClaimStrategy, WaitStrategy> barrier_type;
+
+    // Construct a BasicSequencer with compile time strategies.
+    //
+    // @param buffer_size over which sequences are valid.
+    explicit BasicSequencer(int buffer_size)
+        : buffer_size_(ceilToPow2(buffer_size))
+        , claim_strategy_(buffer_size_)
+        , barrier_wait_strategies_(new BarrierWaitStrategies())
+    {
+    }
+
+    // Construct a Sequencer with the selected strategies, only available
+    // with the {@link RuntimeClaimStrategy} and {@link RuntimeWaitStrategy}
+    // policies.
     //
     // @param buffer_size over which sequences are valid.
     // @param claim_strategy_option for those claiming sequences.
     // @param wait_strategy_option for those waiting on sequences.
-    Sequencer(int buffer_size,
-              ClaimStrategyOption claim_strategy_option,
-              WaitStrategyOption wait_strategy_option,
-              const TimeConfig& timeConfig=TimeConfig())
+    BasicSequencer(int buffer_size,
+                   ClaimStrategyOption claim_strategy_option,
+                   WaitStrategyOption wait_strategy_option,
+                   const TimeConfig& timeConfig=TimeConfig())
         : buffer_size_(ceilToPow2(buffer_size))
-        , claim_strategy_(createClaimStrategy(claim_strategy_option, buffer_size_))
-        , wait_strategy_(createWaitStrategy(wait_strategy_option, timeConfig))
+        , claim_strategy_(buffer_size_, claim_strategy_option)
+        , wait_strategy_(wait_strategy_option, timeConfig)
+        , barrier_wait_strategies_(new BarrierWaitStrategies())
     {
     }
 
-    virtual ~Sequencer()
+    // Construct a Sequencer with the selected strategies, including the one
+    // of the publishers waiting on a full buffer. Only available with the
+    // {@link RuntimeClaimStrategy} and {@link RuntimeWaitStrategy} policies.
+    //
+    // @param buffer_size over which sequences are valid.
+    // @param claim_strategy_option for those claiming sequences.
+    // @param wait_strategy_option for those waiting on sequences.
+    // @param producer_wait_strategy_option for those claiming sequences
+    // when the buffer is full.
+    BasicSequencer(int buffer_size,
+                   ClaimStrategyOption claim_strategy_option,
+                   WaitStrategyOption wait_strategy_option,
+                   ProducerWaitStrategyOption producer_wait_strategy_option,
+                   const TimeConfig& timeConfig=TimeConfig())
+        : buffer_size_(ceilToPow2(buffer_size))
+        , claim_strategy_(buffer_size_, claim_strategy_option,
+                          producer_wait_strategy_option, timeConfig)
+        , wait_strategy_(wait_strategy_option, timeConfig)
+        , barrier_wait_strategies_(new BarrierWaitStrategies())
+    {
+    }
+
+    virtual ~BasicSequencer()
     {
     }
 
@@ -38,18 +91,137 @@ public:
     // @param sequences to be gated on.
     void setGatingSequences(const DependentSequences& sequences)
     {
-        gating_sequences_ = sequences;
+        stdext::lock_guard<stdext::mutex> lock(gating_sequences_mutex_);
+        gating_sequences_.store(sequences);
+    }
+
+    // Add sequences to gate the publishers on while they are publishing,
+    // e.g. to attach a consumer to a live {@link RingBuffer}. The added
+    // sequences are set to the cursor, so their consumers start with the
+    // next published event.
+    //
+    // @param sequences to be added to the gating sequences.
+    void addGatingSequences(const DependentSequences& sequences)
+    {
+        stdext::lock_guard<stdext::mutex> lock(gating_sequences_mutex_);
+        DependentSequences updated(gating_sequences_.load()->sequences());
+        updated.insert(updated.end(), sequences.begin(), sequences.end());
+
+        setSequences(sequences, cursor_.get());
+        gating_sequences_.store(updated);
+
+        // publishers may have moved the cursor before they saw the swap, the
+        // added sequences must not gate them behind what they published
+        setSequences(sequences, cursor_.get());
+    }
+
+    // Remove sequences from the gating sequences while the publishers are
+    // publishing.
+    //
+    // @param sequences to be removed from the gating sequences.
+    // @return true if any of the sequences was gating the publishers.
+    bool removeGatingSequences(const DependentSequences& sequences)
+    {
+        stdext::lock_guard<stdext::mutex> lock(gating_sequences_mutex_);
+        const GatingSequences* snapshot = gating_sequences_.load();
+        const DependentSequences& current = snapshot->sequences();
+        DependentSequences updated;
+        updated.reserve(current.size());
+        for (size_t i = 0; i < current.size(); ++i) {
+            if (std::find(sequences.begin(), sequences.end(), current[i])
+                    == sequences.end()) {
+                updated.push_back(current[i]);
+            }
+        }
+
+        bool removed = updated.size() != current.size();
+        gating_sequences_.store(updated);
+        return removed;
+    }
+
+    // Free the gating sequences and the lists of barrier wait strategies
+    // replaced so far, which publishers may still be reading until then.
+    // Only call when no other thread is using the sequencer, e.g. once the
+    // publishers are joined.
+    void reclaim()
+    {
+        {
+            stdext::lock_guard<stdext::mutex> lock(gating_sequences_mutex_);
+            gating_sequences_.reclaim();
+        }
+        stdext::lock_guard<stdext::mutex> lock(barrier_wait_strategies_mutex_);
+        barrier_wait_strategies_.reclaim();
     }
 
     // Create a {@link SequenceBarrier} that gates on the cursor and a list of
     // {@link Sequence}s.
     //
+    // The barrier is registered with the wait strategy until it is
+    // destroyed, which must happen before the sequencer is.
+    //
+    // @param sequences_to_track this barrier will track.
+    // @return the barrier gated as required.
+    // @throws std::exception if the wait strategy can not take another
+    // barrier, e.g. {@link EventFdStrategy#kMaxWaiters}.
+    stdext::shared_ptr<barrier_type> newBarrier(
+            const DependentSequences& sequences_to_track)
+    {
+        return createBarrier(sequences_to_track, &wait_strategy_,
+                             stdext::shared_ptr<WaitStrategy>());
+    }
+
+    // Create a {@link SequenceBarrier} whose consumers wait with their own
+    // strategy rather than the one of the sequencer, e.g. to busy spin a
+    // latency critical consumer while the others of the ring park. Only
+    // available with the {@link RuntimeWaitStrategy} policy.
+    //
+    // Publishers signal the strategy when it can block, until the barrier
+    // is destroyed, which adds a call per publication and per blocking
+    // barrier strategy. Until such a strategy is registered publishers only
+    // load the pointer to an empty list.
+    //
     // @param sequences_to_track this barrier will track.
+    // @param wait_strategy_option for the consumers of this barrier.
     // @return the barrier gated as required.
-    SequenceBarrierPtr newBarrier(const DependentSequences& sequences_to_track)
+    stdext::shared_ptr<barrier_type> newBarrier(
+            const DependentSequences& sequences_to_track,
+            WaitStrategyOption wait_strategy_option,
+            const TimeConfig& timeConfig=TimeConfig())
+    {
+        return newBarrier(sequences_to_track,
+                stdext::make_shared<WaitStrategy>(wait_strategy_option,
+                                                  timeConfig));
+    }
+
+    // Create a {@link SequenceBarrier} whose consumers wait with the given
+    // strategy, see above.
+    //
+    // @param sequences_to_track this barrier will track.
+    // @param wait_strategy for the consumers of this barrier, kept alive by
+    // the barrier.
+    // @return the barrier gated as required, whose destruction unregisters
+    // the strategy from the publishers.
+    stdext::shared_ptr<barrier_type> newBarrier(
+            const DependentSequences& sequences_to_track,
+            const stdext::shared_ptr<WaitStrategy>& wait_strategy)
+    {
+        return createBarrier(sequences_to_track, wait_strategy.get(),
+                             wait_strategy);
+    }
+
+    // Get the wait strategy, e.g. to register the descriptor of an
+    // {@link EventFdStrategy} in an epoll set.
+    //
+    // @return the wait strategy of those waiting on sequences.
+    WaitStrategy& getWaitStrategy() { return wait_strategy_; }
+
+    // Get the number of times publishers found the buffer full, a growing
+    // count means the consumers do not keep up.
+    //
+    // @return the number of producer stalls.
+    int64_t getProducerStallCount() const
     {
-        return stdext::make_shared<ProcessingSequenceBarrier>(
-                wait_strategy_.get(), &cursor_, sequences_to_track );
+        return claim_strategy_.getStallCount();
     }
 
     // The capacity of the data structure to hold entries.
@@ -70,7 +242,7 @@ public:
     // @return true if the buffer has the capacity to allocated another event.
     bool hasAvailableCapacity() const
     {
-        return claim_strategy_->hasAvailableCapacity(gating_sequences_);
+        return claim_strategy_.hasAvailableCapacity(gatingSequences());
     }
 
     // Get the remaining capacity for this sequencer.
@@ -86,7 +258,7 @@ public:
     // @return The number of slots taken.
     int occupiedCapacity() const
     {
-        int64_t consumed = getMinimumSequence(gating_sequences_);
+        int64_t consumed = gatingSequences().getMinimumSequence();
         int64_t produced = cursor_.get();
         return static_cast<int>((buffer_size_ + produced - consumed) % buffer_size_);
     }
@@ -97,7 +269,48 @@ public:
     int64_t next()
     {
         // TODO: check gatingSequence, throw exception if it's empty
-        return claim_strategy_->incrementAndGet(gating_sequences_);
+        return claim_strategy_.incrementAndGet(gatingSequences());
+    }
+
+    // Claim the next n events in sequence for publishing to the
+    // {@link RingBuffer}, with a single update of the claim sequence.
+    //
+    // @param n number of events to claim, between 1 and capacity().
+    // @return the highest claimed sequence, the batch starts at the
+    // returned value - n + 1.
+    int64_t next(const int& n)
+    {
+        if (n < 1 || n > buffer_size_) {
+            throw std::invalid_argument("n must be > 0 and <= capacity()");
+        }
+        return claim_strategy_.incrementAndGet(n, gatingSequences());
+    }
+
+    // Try to claim the next event in sequence for publishing to the
+    // {@link RingBuffer} without blocking.
+    //
+    // @param sequence set to the claimed sequence on success.
+    // @return true if the sequence was claimed, false if the buffer is full.
+    bool tryNext(int64_t& sequence)
+    {
+        return claim_strategy_.tryIncrementAndGet(1, gatingSequences(),
+                                                   sequence);
+    }
+
+    // Try to claim the next n events in sequence without blocking. Either
+    // all n events are claimed or none are.
+    //
+    // @param n number of events to claim, between 1 and capacity().
+    // @param sequence set to the highest claimed sequence on success.
+    // @return true if the sequences were claimed, false if the buffer does
+    // not have capacity for n more events.
+    bool tryNext(const int& n, int64_t& sequence)
+    {
+        if (n < 1 || n > buffer_size_) {
+            throw std::invalid_argument("n must be > 0 and <= capacity()");
+        }
+        return claim_strategy_.tryIncrementAndGet(n, gatingSequences(),
+                                                   sequence);
     }
 
     // Claim a specific sequence when only one publisher is involved.
@@ -106,7 +319,7 @@ public:
     // @return sequence just claime.
     int64_t claim(const int64_t& sequence)
     {
-        claim_strategy_->setSequence(sequence, gating_sequences_);
+        claim_strategy_.setSequence(sequence, gatingSequences());
         return sequence;
     }
 
@@ -115,7 +328,19 @@ public:
     // @param sequence to be published.
     void publish(const int64_t& sequence)
     {
-        this->publish(sequence, 1); // Publish the batch of events in sequence.
+        this->publish(sequence, sequence);
+    }
+
+    // Publish a batch of events claimed with {@link #next(int)} and make
+    // them visible to {@link EventProcessor}s with one cursor update and
+    // one wake-up.
+    //
+    // @param lo first sequence of the batch.
+    // @param hi last sequence of the batch.
+    void publish(const int64_t& lo, const int64_t& hi)
+    {
+        claim_strategy_.serialisePublishing(hi, cursor_, hi - lo + 1);
+        signalAllWhenBlocking();
     }
 
     // Force the publication of a cursor sequence.
@@ -128,29 +353,150 @@ public:
     void forcePublish(const int64_t& sequence)
     {
         cursor_.set(sequence);
-        wait_strategy_->signalAllWhenBlocking();
+        signalAllWhenBlocking();
     }
 
 protected:
-    const int buffer_size_;
+    // The gating sequences, read by the claim strategies.
+    const AtomicGatingSequences& gatingSequences() const
+    {
+        return gating_sequences_;
+    }
 
-    void publish(const int64_t& sequence, const int64_t& batch_size)
+    // Signal the wait strategy of the sequencer and the blocking ones of
+    // the barriers created with their own.
+    void signalAllWhenBlocking()
     {
-        claim_strategy_->serialisePublishing(sequence, cursor_, batch_size);
-        wait_strategy_->signalAllWhenBlocking();
+        wait_strategy_.signalAllWhenBlocking();
+        const BarrierWaitStrategies* strategies =
+            barrier_wait_strategies_.load();
+        for (size_t i = 0; i < strategies->size(); ++i) {
+            (*strategies)[i]->signalAllWhenBlocking();
+        }
     }
 
+    const int buffer_size_;
+
     Sequence cursor_;
-    DependentSequences gating_sequences_;
 
-    ClaimStrategyPtr claim_strategy_;
-    WaitStrategyPtr wait_strategy_;
+    // mutable as claim strategies cache the minimum gating sequence even
+    // when only asked about capacity.
+    mutable ClaimStrategy claim_strategy_;
+    WaitStrategy wait_strategy_;
 
 private:
-    Sequencer(const Sequencer& s);
-    Sequencer& operator= (Sequencer s);
+    // the blocking wait strategies of the barriers created with their own
+    typedef std::vector<stdext::shared_ptr<WaitStrategy> >
+        BarrierWaitStrategies;
+
+    // Deleter of the barriers, which unregisters the barrier from its wait
+    // strategy, and from the publishers if they signal the strategy, before
+    // deleting it. Holds the strategy of a barrier created with its own for
+    // as long as the barrier.
+    class BarrierDeleter
+    {
+    public:
+        BarrierDeleter(BasicSequencer* sequencer,
+                       WaitStrategy* wait_strategy,
+                       const stdext::shared_ptr<WaitStrategy>& owned,
+                       bool signalled)
+            : sequencer_(sequencer)
+            , wait_strategy_(wait_strategy)
+            , owned_(owned)
+            , signalled_(signalled)
+        {
+        }
+
+        void operator() (barrier_type* barrier)
+        {
+            if (signalled_) {
+                sequencer_->removeBarrierWaitStrategy(wait_strategy_);
+            }
+            wait_strategy_->unregisterBarrier(*barrier);
+            delete barrier;
+        }
+
+    private:
+        BasicSequencer* sequencer_;
+        WaitStrategy* wait_strategy_;
+        stdext::shared_ptr<WaitStrategy> owned_;
+        bool signalled_;
+    };
+
+    // Create a barrier registered with its wait strategy, and with the
+    // publishers when the strategy is a blocking one of its own.
+    //
+    // @param owned the strategy of a barrier created with its own, else
+    // empty.
+    stdext::shared_ptr<barrier_type> createBarrier(
+            const DependentSequences& sequences_to_track,
+            WaitStrategy* wait_strategy,
+            const stdext::shared_ptr<WaitStrategy>& owned)
+    {
+        barrier_type* barrier = new barrier_type(wait_strategy,
+                &claim_strategy_, &cursor_, sequences_to_track);
+        try {
+            wait_strategy->registerBarrier(*barrier);
+        }
+        catch (...) {
+            delete barrier;
+            throw;
+        }
+
+        const bool signalled = owned && wait_strategy->isBlocking();
+        if (signalled) {
+            stdext::lock_guard<stdext::mutex> lock(
+                    barrier_wait_strategies_mutex_);
+            BarrierWaitStrategies* updated =
+                new BarrierWaitStrategies(*barrier_wait_strategies_.load());
+            updated->push_back(owned);
+            barrier_wait_strategies_.store(updated);
+        }
+
+        return stdext::shared_ptr<barrier_type>(barrier,
+                BarrierDeleter(this, wait_strategy, owned, signalled));
+    }
+
+    // Stop signalling a blocking wait strategy of a barrier, once per
+    // registration as barriers may share their strategy.
+    void removeBarrierWaitStrategy(const WaitStrategy* wait_strategy)
+    {
+        stdext::lock_guard<stdext::mutex> lock(barrier_wait_strategies_mutex_);
+        const BarrierWaitStrategies* current = barrier_wait_strategies_.load();
+        for (size_t i = 0; i < current->size(); ++i) {
+            if ((*current)[i].get() == wait_strategy) {
+                BarrierWaitStrategies* updated =
+                    new BarrierWaitStrategies(*current);
+                updated->erase(updated->begin() + i);
+                barrier_wait_strategies_.store(updated);
+                return;
+            }
+        }
+    }
+
+    static void setSequences(const DependentSequences& sequences,
+                             const int64_t& value)
+    {
+        for (size_t i = 0; i < sequences.size(); ++i) {
+            sequences[i]->set(value);
+        }
+    }
+
+    AtomicGatingSequences gating_sequences_;
+    // serialises the updates of the gating sequences
+    stdext::mutex gating_sequences_mutex_;
+    // read by the publishers, an empty list until a barrier with a blocking
+    // strategy of its own is created
+    AtomicSnapshot<BarrierWaitStrategies> barrier_wait_strategies_;
+    // serialises the updates of the barrier wait strategies
+    stdext::mutex barrier_wait_strategies_mutex_;
+
+    BasicSequencer(const BasicSequencer& s);
+    BasicSequencer& operator= (BasicSequencer s);
 };
 
+typedef BasicSequencer<RuntimeClaimStrategy, RuntimeWaitStrategy> Sequencer;
+
 }
 
 #endif
@@ -2,10 +2,16 @@
 #define DISRUPTOR_UTILS_H_
 
 #include <climits>
+#include <cstring>
+#include <stdint.h>
 #include <vector>
 #include <map>
 #include <memory>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 // According to Stroustrup, in C++11 the macro __cplusplus will be set to a
 // value that differs from (is greater than) the current 199711L.
 #if __cplusplus <= 199711L
@@ -31,7 +37,15 @@ namespace disruptor {
 
 enum TimeConfigKey {
     kSleep,
-    kMaxIdle
+    kMaxIdle,
+    // time spent spinning before parking or yielding, see
+    // {@link FutexStrategy} and {@link PhasedBackoffStrategy}.
+    kSpin,
+    // time spent yielding after spinning, see {@link PhasedBackoffStrategy}.
+    kYield,
+    // expected wake up latency accepted to save CPU, see
+    // {@link AdaptiveStrategy}.
+    kLatencyBudget
 };
 
 typedef std::map<TimeConfigKey, stdext::chrono::microseconds> TimeConfig;
@@ -64,6 +78,103 @@ inline size_t ceilToPow2(size_t x)
     return x;
 }
 
+// Exponent of the highest power of 2 not greater than x, which is exactly
+// log2(x) for the power of 2 sizes returned by ceilToPow2.
+inline int floorLog2(size_t x)
+{
+    int exponent = 0;
+    while (x >>= 1) {
+        ++exponent;
+    }
+    return exponent;
+}
+
+// Most pause hints issued by one {@link SpinBackoff#pause()}.
+const int MAX_SPIN_PAUSES = 16;
+
+// Hint to the CPU that the thread is in a spin-wait loop, so it stops
+// speculating ahead on the spinning load, avoiding the memory order machine
+// clear on exit, and leaves the core's resources to its SMT sibling.
+inline void cpuPause()
+{
+#if defined(__i386__) || defined(__x86_64__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    __asm__ __volatile__("yield" ::: "memory");
+#else
+    __asm__ __volatile__("" ::: "memory");
+#endif
+}
+
+// Copy size bytes with non-temporal stores, which bypass the caches of the
+// writing core: for large payloads the writer never reads back, they leave
+// its working set alone. The unaligned head and tail are copied with
+// regular stores. Falls back to memcpy without SSE2.
+//
+// Non-temporal stores are weakly ordered, call {@link #streamingFence()}
+// before publishing what was copied.
+//
+// @param destination to copy to.
+// @param source to copy from.
+// @param size in bytes to copy.
+inline void streamingCopy(void* destination, const void* source, size_t size)
+{
+#if defined(__SSE2__)
+    char* to = static_cast<char*>(destination);
+    const char* from = static_cast<const char*>(source);
+    size_t head = (16 - (reinterpret_cast<uintptr_t>(to) & 15)) & 15;
+    if (head > size) {
+        head = size;
+    }
+    memcpy(to, from, head);
+    to += head;
+    from += head;
+    size -= head;
+
+    for ( ; size >= 16; size -= 16, to += 16, from += 16) {
+        _mm_stream_si128(reinterpret_cast<__m128i*>(to),
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(from)));
+    }
+    memcpy(to, from, size);
+#else
+    memcpy(destination, source, size);
+#endif
+}
+
+// Order the non-temporal stores of {@link #streamingCopy()} before the
+// following stores, e.g. the publication of the cursor.
+inline void streamingFence()
+{
+#if defined(__SSE2__)
+    _mm_sfence();
+#endif
+}
+
+// Exponential backoff for spin-wait loops. Each {@link #pause()} issues twice
+// as many pause hints as the previous one, up to MAX_SPIN_PAUSES, so a short
+// wait stays responsive while a long one mostly leaves the core to its
+// sibling.
+class SpinBackoff
+{
+public:
+    SpinBackoff() : pauses_(1) {}
+
+    void pause()
+    {
+        for (int i = 0; i < pauses_; ++i) {
+            cpuPause();
+        }
+        if (pauses_ < MAX_SPIN_PAUSES) {
+            pauses_ <<= 1;
+        }
+    }
+
+    void reset() { pauses_ = 1; }
+
+private:
+    int pauses_;
+};
+
 }
 
 #endif
@@ -1,8 +1,22 @@
 #ifndef DISRUPTOR_WAIT_STRATEGY_H_
 #define DISRUPTOR_WAIT_STRATEGY_H_
 
-#include <sys/time.h>
+#include <time.h>
 
+#include <algorithm>
+#include <cmath>
+
+#ifdef __linux__
+#include <errno.h>
+#include <linux/futex.h>
+#include <poll.h>
+#include <stdexcept>
+#include <sys/eventfd.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <disruptor/clock.h>
 #include <disruptor/exceptions.h>
 #include <disruptor/interface.h>
 
@@ -24,7 +38,34 @@ enum WaitStrategyOption {
     kYieldingStrategy,
     // This strategy call spins in a loop as a waiting strategy which is
     // lowest and most consistent latency but ties up a CPU.
-    kBusySpinStrategy
+    kBusySpinStrategy,
+    // This strategy blocks like the blocking strategy, but publishers only
+    // take the lock and signal when an event processor is actually waiting.
+    kLiteBlockingStrategy,
+    // These strategies spin for the kSpin time, then yield for the kYield
+    // time, then fall back to the blocking, lite blocking or sleeping
+    // strategy. They catch bursts within the spin window without involving
+    // the scheduler, yet do not burn a CPU when idle.
+    kPhasedBackoffBlockingStrategy,
+    kPhasedBackoffLiteBlockingStrategy,
+    kPhasedBackoffSleepingStrategy,
+    // This strategy busy spins like the busy spin strategy, but with an
+    // exponentially growing number of CPU pause hints between checks, which
+    // leaves most of the core to its SMT sibling.
+    kPausingBusySpinStrategy,
+    // This strategy spins, yields then parks, tuning the time spent in each
+    // phase online from the observed gaps between events to keep the
+    // expected wake up latency within the kLatencyBudget time config.
+    kAdaptiveStrategy,
+#ifdef __linux__
+    // This strategy spins for a short time then parks on a futex, which
+    // wakes up within microseconds without burning a CPU when idle. The spin
+    // time is the kSpin time config. Linux only.
+    kFutexStrategy,
+    // This strategy parks on an eventfd, which can also be registered in an
+    // epoll set to wait on a ring and sockets together. Linux only.
+    kEventFdStrategy
+#endif
 };
 
 // Blocking strategy that uses a lock and condition variable for
@@ -53,9 +94,11 @@ public:
         } // unlock happens here, on ulock destruction.
 
         if (0 != dependents.size()) {
+            SpinBackoff backoff;
             while ((available_sequence
                         = getMinimumSequence(dependents)) < sequence) {
                 barrier.checkAlert();
+                backoff.pause();
             }
         }
 
@@ -81,9 +124,11 @@ public:
         } // unlock happens here, on ulock destruction
 
         if (0 != dependents.size()) {
+            SpinBackoff backoff;
             while ((available_sequence
                         = getMinimumSequence(dependents)) < sequence) {
                 barrier.checkAlert();
+                backoff.pause();
             }
         }
 
@@ -101,10 +146,109 @@ private:
     stdext::condition_variable_any consumer_notify_condition_;
 };
 
+// Variation of the {@link BlockingStrategy} where the publishers skip the
+// lock and the notification when no {@link Consumer} is blocked.
+//
+// Waiting consumers register in an atomic counter before checking the cursor
+// under the lock, and publishers check the counter after moving the cursor,
+// so the signal is only paid for when the consumer is idle.
+class LiteBlockingStrategy : public IWaitStrategy
+{
+public:
+    LiteBlockingStrategy() : waiters_(0) {}
+
+    virtual int64_t waitFor(const int64_t& sequence,
+                            const Sequence& cursor,
+                            const DependentSequences& dependents,
+                            const ISequenceBarrier& barrier)
+    {
+        int64_t available_sequence = 0;
+        if ((available_sequence = cursor.get()) < sequence) {
+            stdext::unique_lock<stdext::mutex> ulock(mutex_);
+            waiters_.fetch_add(1);
+            stdext::atomic_thread_fence(stdext::memory_order_seq_cst);
+            while ((available_sequence = cursor.get()) < sequence) {
+                if (barrier.isAlerted()) {
+                    break;
+                }
+                consumer_notify_condition_.wait(ulock);
+            }
+            waiters_.fetch_sub(1);
+        }
+        barrier.checkAlert();
+
+        if (0 != dependents.size()) {
+            SpinBackoff backoff;
+            while ((available_sequence
+                        = getMinimumSequence(dependents)) < sequence) {
+                barrier.checkAlert();
+                backoff.pause();
+            }
+        }
+
+        return available_sequence;
+    }
+
+    virtual int64_t waitFor(const int64_t& sequence,
+                            const Sequence& cursor,
+                            const DependentSequences& dependents,
+                            const ISequenceBarrier& barrier,
+                            const stdext::chrono::microseconds& timeout)
+    {
+        int64_t available_sequence = 0;
+        if ((available_sequence = cursor.get()) < sequence) {
+            stdext::unique_lock<stdext::mutex> ulock(mutex_);
+            waiters_.fetch_add(1);
+            stdext::atomic_thread_fence(stdext::memory_order_seq_cst);
+            while ((available_sequence = cursor.get()) < sequence) {
+                if (barrier.isAlerted() ||
+                        consumer_notify_condition_.wait_for(ulock, timeout)
+                        == stdext::cv_status::timeout) {
+                    break;
+                }
+            }
+            waiters_.fetch_sub(1);
+        }
+        barrier.checkAlert();
+
+        if (0 != dependents.size()) {
+            SpinBackoff backoff;
+            while ((available_sequence
+                        = getMinimumSequence(dependents)) < sequence) {
+                barrier.checkAlert();
+                backoff.pause();
+            }
+        }
+
+        return available_sequence;
+    }
+
+    virtual void signalAllWhenBlocking()
+    {
+        // pairs with the fence of the waiters so either the publisher sees
+        // the waiter, or the waiter sees the moved cursor
+        stdext::atomic_thread_fence(stdext::memory_order_seq_cst);
+        if (waiters_.load(stdext::memory_order_relaxed) != 0) {
+            stdext::unique_lock<stdext::mutex> ulock(mutex_);
+            consumer_notify_condition_.notify_all();
+        }
+    }
+
+private:
+    stdext::atomic<int> waiters_;
+    stdext::mutex mutex_;
+    stdext::condition_variable consumer_notify_condition_;
+};
+
 // Sleeping strategy
 class SleepingStrategy : public IWaitStrategy
 {
 public:
+    SleepingStrategy()
+        : sleep_time_(stdext::chrono::milliseconds(1))
+    {
+    }
+
     SleepingStrategy(const stdext::chrono::microseconds& sleep_time)
         : sleep_time_(sleep_time)
     {
@@ -139,11 +283,9 @@ public:
                             const ISequenceBarrier& barrier,
                             const stdext::chrono::microseconds& timeout)
     {
-        int64_t timeout_micros = timeout.total_microseconds();
-        struct timeval start_time, end_time;
-        gettimeofday(&start_time, NULL);
-        int64_t start_micro
-            = (int64_t)start_time.tv_sec*1000*1000 + start_time.tv_usec;
+        // sleeps once the retries are spent, so check the clock on each
+        // sleep.
+        Deadline deadline(timeout, 1);
 
         int64_t available_sequence = 0;
         int counter = retries;
@@ -151,10 +293,7 @@ public:
         if (0 == dependents.size()) {
             while ((available_sequence = cursor.get()) < sequence) {
                 counter = applyWaitMethod(barrier, counter);
-                gettimeofday(&end_time, NULL);
-                int64_t end_micro
-                    = (int64_t)end_time.tv_sec*1000*1000 + end_time.tv_usec;
-                if (timeout_micros < (end_micro - start_micro))
+                if (counter == 0 && deadline.expired())
                     break;
             }
         }
@@ -162,10 +301,7 @@ public:
             while ((available_sequence
                         = getMinimumSequence(dependents)) < sequence) {
                 counter = applyWaitMethod(barrier, counter);
-                gettimeofday(&end_time, NULL);
-                int64_t end_micro
-                    = (int64_t)end_time.tv_sec*1000*1000 + end_time.tv_usec;
-                if (timeout_micros < (end_micro - start_micro))
+                if (counter == 0 && deadline.expired())
                     break;
             }
         }
@@ -175,6 +311,8 @@ public:
 
     virtual void signalAllWhenBlocking() {}
 
+    virtual bool isBlocking() const { return false; }
+
     static const int retries = 10;
 
 private:
@@ -237,11 +375,8 @@ public:
                             const ISequenceBarrier& barrier,
                             const stdext::chrono::microseconds& timeout)
     {
-        int64_t timeout_micros = timeout.total_microseconds();
-        struct timeval start_time, end_time;
-        gettimeofday(&start_time, NULL);
-        int64_t start_micro
-            = (int64_t)start_time.tv_sec*1000*1000 + start_time.tv_usec;
+        // a yield costs more than a clock read
+        Deadline deadline(timeout, 1);
 
         int64_t available_sequence = 0;
         int counter = retries;
@@ -249,10 +384,7 @@ public:
         if (0 == dependents.size()) {
             while ((available_sequence = cursor.get()) < sequence) {
                 counter = applyWaitMethod(barrier, counter);
-                gettimeofday(&end_time, NULL);
-                int64_t end_micro
-                    = (int64_t)end_time.tv_sec*1000*1000 + end_time.tv_usec;
-                if (timeout_micros < (end_micro - start_micro))
+                if (deadline.expired())
                     break;
             }
         }
@@ -260,10 +392,7 @@ public:
             while ((available_sequence
                         = getMinimumSequence(dependents)) < sequence) {
                 counter = applyWaitMethod(barrier, counter);
-                gettimeofday(&end_time, NULL);
-                int64_t end_micro
-                    = (int64_t)end_time.tv_sec*1000*1000 + end_time.tv_usec;
-                if (timeout_micros < (end_micro - start_micro))
+                if (deadline.expired())
                     break;
             }
         }
@@ -273,6 +402,8 @@ public:
 
     virtual void signalAllWhenBlocking() {}
 
+    virtual bool isBlocking() const { return false; }
+
     static const int retries = 10;
 
 private:
@@ -327,20 +458,13 @@ public:
                             const ISequenceBarrier& barrier,
                             const stdext::chrono::microseconds& timeout)
     {
-        int64_t timeout_micros = timeout.total_microseconds();
-        struct timeval start_time, end_time;
-        gettimeofday(&start_time, NULL);
-        int64_t start_micro
-            = (int64_t)start_time.tv_sec*1000*1000 + start_time.tv_usec;
+        Deadline deadline(timeout);
         int64_t available_sequence = 0;
 
         if (0 == dependents.size()) {
             while ((available_sequence = cursor.get()) < sequence) {
                 barrier.checkAlert();
-                gettimeofday(&end_time, NULL);
-                int64_t end_micro
-                    = (int64_t)end_time.tv_sec*1000*1000 + end_time.tv_usec;
-                if (timeout_micros < (end_micro - start_micro))
+                if (deadline.expired())
                     break;
             }
         }
@@ -348,10 +472,7 @@ public:
             while ((available_sequence
                         = getMinimumSequence(dependents)) < sequence) {
                 barrier.checkAlert();
-                gettimeofday(&end_time, NULL);
-                int64_t end_micro
-                    = (int64_t)end_time.tv_sec*1000*1000 + end_time.tv_usec;
-                if (timeout_micros < (end_micro - start_micro))
+                if (deadline.expired())
                     break;
             }
         }
@@ -361,8 +482,902 @@ public:
 
 
     virtual void signalAllWhenBlocking() {}
+
+    virtual bool isBlocking() const { return false; }
+};
+
+// Variation of the {@link BusySpinStrategy} that issues CPU pause hints
+// between checks through a {@link SpinBackoff}.
+// Prefer it over the {@link BusySpinStrategy} when the spinning thread shares
+// a core with other hyper threads, at the cost of up to MAX_SPIN_PAUSES pause
+// hints of extra latency.
+class PausingBusySpinStrategy : public IWaitStrategy
+{
+public:
+    PausingBusySpinStrategy() {}
+
+    virtual int64_t waitFor(const int64_t& sequence,
+            const Sequence& cursor,
+            const DependentSequences& dependents,
+            const ISequenceBarrier& barrier)
+    {
+        int64_t available_sequence = 0;
+        SpinBackoff backoff;
+        if (0 == dependents.size()) {
+            while ((available_sequence = cursor.get()) < sequence) {
+                barrier.checkAlert();
+                backoff.pause();
+            }
+        } else {
+            while ((available_sequence
+                        = getMinimumSequence(dependents)) < sequence) {
+                barrier.checkAlert();
+                backoff.pause();
+            }
+        }
+
+        return available_sequence;
+    }
+
+    virtual int64_t waitFor(const int64_t& sequence,
+                            const Sequence& cursor,
+                            const DependentSequences& dependents,
+                            const ISequenceBarrier& barrier,
+                            const stdext::chrono::microseconds& timeout)
+    {
+        // up to MAX_SPIN_PAUSES pauses cost more than a clock read
+        Deadline deadline(timeout, 1);
+        int64_t available_sequence = 0;
+        SpinBackoff backoff;
+
+        while ((available_sequence = dependents.empty() ?
+                    cursor.get() : getMinimumSequence(dependents))
+                < sequence) {
+            barrier.checkAlert();
+            backoff.pause();
+            if (deadline.expired()) {
+                break;
+            }
+        }
+
+        return available_sequence;
+    }
+
+    virtual void signalAllWhenBlocking() {}
+
+    virtual bool isBlocking() const { return false; }
+};
+
+// Phased wait strategy for {@link EventProcessor}s waiting on a barrier.
+//
+// The consumer spins for spin_time, then yields for yield_time, then hands
+// over to a fallback strategy such as the {@link BlockingStrategy} or the
+// {@link SleepingStrategy}. The phases are timed from the start of the wait
+// with {@link Deadline}s, read every kSpinTries spins and after every yield.
+class PhasedBackoffStrategy : public IWaitStrategy
+{
+public:
+    PhasedBackoffStrategy(const stdext::chrono::nanoseconds& spin_time,
+                          const stdext::chrono::nanoseconds& yield_time,
+                          const WaitStrategyPtr& fallback)
+        : spin_timeout_(spin_time)
+        , yield_timeout_(spin_time + yield_time)
+        , fallback_(fallback)
+    {
+    }
+
+    virtual int64_t waitFor(const int64_t& sequence,
+                            const Sequence& cursor,
+                            const DependentSequences& dependents,
+                            const ISequenceBarrier& barrier)
+    {
+        int64_t available_sequence = 0;
+        if (backoff(sequence, cursor, dependents, barrier, yield_timeout_,
+                    available_sequence)) {
+            return available_sequence;
+        }
+
+        return fallback_->waitFor(sequence, cursor, dependents, barrier);
+    }
+
+    virtual int64_t waitFor(const int64_t& sequence,
+                            const Sequence& cursor,
+                            const DependentSequences& dependents,
+                            const ISequenceBarrier& barrier,
+                            const stdext::chrono::microseconds& timeout)
+    {
+        int64_t available_sequence = 0;
+        Deadline deadline(timeout, 1);
+        if (backoff(sequence, cursor, dependents, barrier,
+                    stdext::chrono::nanoseconds(timeout) < yield_timeout_ ?
+                        stdext::chrono::nanoseconds(timeout) : yield_timeout_,
+                    available_sequence)) {
+            return available_sequence;
+        }
+
+        int64_t remaining_nanos = deadline.remainingNanos();
+        if (remaining_nanos == 0) {
+            return available_sequence;
+        }
+        return fallback_->waitFor(sequence, cursor, dependents, barrier,
+                stdext::chrono::duration_cast<stdext::chrono::microseconds>(
+                    stdext::chrono::nanoseconds(remaining_nanos)));
+    }
+
+    virtual void signalAllWhenBlocking()
+    {
+        fallback_->signalAllWhenBlocking();
+    }
+
+    virtual bool isBlocking() const { return fallback_->isBlocking(); }
+
+    virtual void registerBarrier(const ISequenceBarrier& barrier)
+    {
+        fallback_->registerBarrier(barrier);
+    }
+
+    virtual void unregisterBarrier(const ISequenceBarrier& barrier)
+    {
+        fallback_->unregisterBarrier(barrier);
+    }
+
+    static const int kSpinTries = 10;
+
+private:
+    // Spin for the spin time, then yield, until the sequence is available
+    // or time_limit has passed.
+    //
+    // @return true if the sequence is available.
+    bool backoff(const int64_t& sequence,
+                 const Sequence& cursor,
+                 const DependentSequences& dependents,
+                 const ISequenceBarrier& barrier,
+                 const stdext::chrono::nanoseconds& time_limit,
+                 int64_t& available_sequence)
+    {
+        Deadline deadline(time_limit, 1);
+        Deadline spin_deadline(
+                spin_timeout_ < time_limit ? spin_timeout_ : time_limit,
+                kSpinTries);
+        bool yielding = false;
+        SpinBackoff backoff;
+
+        while ((available_sequence = dependents.empty() ?
+                    cursor.get() : getMinimumSequence(dependents))
+                < sequence) {
+            barrier.checkAlert();
+            if (yielding) {
+                stdext::this_thread::yield();
+                if (deadline.expired()) {
+                    return false;
+                }
+            }
+            else {
+                backoff.pause();
+                yielding = spin_deadline.expired();
+            }
+        }
+
+        return true;
+    }
+
+    const stdext::chrono::nanoseconds spin_timeout_;
+    const stdext::chrono::nanoseconds yield_timeout_;
+    WaitStrategyPtr fallback_;
+};
+
+// Phase of a consumer waiting in an {@link AdaptiveStrategy}.
+enum WaitPhase {
+    // not waiting, events were available.
+    kRunningPhase,
+    kSpinningPhase,
+    kYieldingPhase,
+    kParkedPhase
+};
+
+// Self tuning wait strategy for {@link EventProcessor}s waiting on a
+// barrier.
+//
+// The consumer spins, then yields, then parks on a condition variable like
+// the {@link LiteBlockingStrategy}. The strategy records the gaps the
+// consumers wait for, the fraction of time they are idle and how long a
+// parked consumer takes to wake up once signalled, and retunes the length of
+// the spin and yield phases every kTuneWaits waits, or kTuneWindowNanos:
+//
+//  - waiting w before parking leaves a wake up latency of park latency L
+//    with probability exp(-w / gap) for exponentially distributed gaps, so
+//    the consumer spins and yields for gap * ln(L / budget) to keep the
+//    expected latency within the budget, and parks straight away when L
+//    already fits. That wait is capped to kMaxBackoffNanos.
+//  - the wait is spent spinning in proportion of the busy fraction, and
+//    yielding for the rest, so an idle consumer leaves its core to others.
+class AdaptiveStrategy : public IWaitStrategy
+{
+public:
+    static const int kSpinTries = 100;
+    static const int kTuneWaits = 64;
+    static const int64_t kTuneWindowNanos = 10L * 1000L * 1000L;
+    static const int64_t kMaxBackoffNanos = 1000L * 1000L;
+    static const int64_t kMaxParkNanos = 1000L * 1000L;
+    static const int64_t kInitialParkLatencyNanos = 50L * 1000L;
+
+    // @param latency_budget expected wake up latency the consumers accept to
+    // save CPU.
+    AdaptiveStrategy(const stdext::chrono::microseconds& latency_budget =
+                     stdext::chrono::microseconds(50))
+        : budget_nanos_(std::max<int64_t>(1,
+                stdext::chrono::duration_cast<stdext::chrono::nanoseconds>(
+                    latency_budget).count()))
+        , phase_(kRunningPhase)
+        , spin_nanos_(0)
+        , backoff_nanos_(0)
+        , average_gap_nanos_(budget_nanos_)
+        , park_latency_nanos_(kInitialParkLatencyNanos)
+        , idle_permille_(500)
+        , window_start_nanos_(WaitClock::nanoTime())
+        , window_wait_nanos_(0)
+        , window_waits_(0)
+        , signal_nanos_(0)
+        , waiters_(0)
+    {
+        retune(0.5);
+    }
+
+    virtual int64_t waitFor(const int64_t& sequence,
+                            const Sequence& cursor,
+                            const DependentSequences& dependents,
+                            const ISequenceBarrier& barrier)
+    {
+        return waitFor(sequence, cursor, dependents, barrier, -1);
+    }
+
+    virtual int64_t waitFor(const int64_t& sequence,
+                            const Sequence& cursor,
+                            const DependentSequences& dependents,
+                            const ISequenceBarrier& barrier,
+                            const stdext::chrono::microseconds& timeout)
+    {
+        return waitFor(sequence, cursor, dependents, barrier,
+                stdext::chrono::duration_cast<stdext::chrono::nanoseconds>(
+                    timeout).count());
+    }
+
+    virtual void signalAllWhenBlocking()
+    {
+        // pairs with the fence of the waiters so either the publisher sees
+        // the waiter, or the waiter sees the moved cursor
+        stdext::atomic_thread_fence(stdext::memory_order_seq_cst);
+        if (waiters_.load(stdext::memory_order_relaxed) != 0) {
+            stdext::unique_lock<stdext::mutex> ulock(mutex_);
+            signal_nanos_.store(WaitClock::nanoTime(),
+                                stdext::memory_order_relaxed);
+            consumer_notify_condition_.notify_all();
+        }
+    }
+
+    // @return the phase last entered by a waiting consumer, or
+    // kRunningPhase once it found events.
+    WaitPhase getPhase() const
+    {
+        return static_cast<WaitPhase>(
+                phase_.load(stdext::memory_order_relaxed));
+    }
+
+    // @return the time a consumer currently spins before yielding.
+    stdext::chrono::nanoseconds getSpinTime() const
+    {
+        return stdext::chrono::nanoseconds(
+                spin_nanos_.load(stdext::memory_order_relaxed));
+    }
+
+    // @return the time a consumer currently spins and yields before
+    // parking.
+    stdext::chrono::nanoseconds getBackoffTime() const
+    {
+        return stdext::chrono::nanoseconds(
+                backoff_nanos_.load(stdext::memory_order_relaxed));
+    }
+
+    // @return the moving average of the waited gaps.
+    stdext::chrono::nanoseconds getAverageGap() const
+    {
+        return stdext::chrono::nanoseconds(
+                average_gap_nanos_.load(stdext::memory_order_relaxed));
+    }
+
+    // @return the moving average of the wake up latency of parked
+    // consumers.
+    stdext::chrono::nanoseconds getParkLatency() const
+    {
+        return stdext::chrono::nanoseconds(
+                park_latency_nanos_.load(stdext::memory_order_relaxed));
+    }
+
+    // @return the fraction of the last tuning window the consumers spent
+    // waiting.
+    double getIdleFraction() const
+    {
+        return idle_permille_.load(stdext::memory_order_relaxed) / 1000.0;
+    }
+
+private:
+    // @param timeout_nanos of the wait, negative to wait until the sequence
+    // is available.
+    int64_t waitFor(const int64_t& sequence,
+                    const Sequence& cursor,
+                    const DependentSequences& dependents,
+                    const ISequenceBarrier& barrier,
+                    const int64_t& timeout_nanos)
+    {
+        int64_t available_sequence = 0;
+        if ((available_sequence = dependents.empty() ?
+                    cursor.get() : getMinimumSequence(dependents))
+                >= sequence) {
+            return available_sequence;
+        }
+
+        const int64_t start_nanos = WaitClock::nanoTime();
+        const int64_t spin_nanos =
+            spin_nanos_.load(stdext::memory_order_relaxed);
+        const int64_t backoff_nanos =
+            backoff_nanos_.load(stdext::memory_order_relaxed);
+        int64_t elapsed = 0;
+        int counter = kSpinTries;
+        SpinBackoff backoff;
+        phase_.store(kSpinningPhase, stdext::memory_order_relaxed);
+
+        while ((available_sequence = dependents.empty() ?
+                    cursor.get() : getMinimumSequence(dependents))
+                < sequence) {
+            barrier.checkAlert();
+            if (elapsed < spin_nanos) {
+                backoff.pause();
+                if (--counter != 0) {
+                    continue;
+                }
+                counter = kSpinTries;
+            }
+            // parked consumers are only signalled on publication, wait for
+            // the dependents by yielding
+            else if (elapsed < backoff_nanos || cursor.get() >= sequence) {
+                phase_.store(kYieldingPhase, stdext::memory_order_relaxed);
+                stdext::this_thread::yield();
+            }
+            else {
+                phase_.store(kParkedPhase, stdext::memory_order_relaxed);
+                int64_t park_nanos = kMaxParkNanos;
+                if (timeout_nanos >= 0 &&
+                        timeout_nanos - elapsed < park_nanos) {
+                    park_nanos = timeout_nanos - elapsed;
+                }
+                park(sequence, cursor, barrier, park_nanos);
+            }
+
+            elapsed = WaitClock::nanoTime() - start_nanos;
+            if (timeout_nanos >= 0 && elapsed >= timeout_nanos) {
+                break;
+            }
+        }
+
+        phase_.store(kRunningPhase, stdext::memory_order_relaxed);
+        int64_t end_nanos = WaitClock::nanoTime();
+        record(end_nanos - start_nanos, end_nanos);
+        return available_sequence;
+    }
+
+    void park(const int64_t& sequence,
+              const Sequence& cursor,
+              const ISequenceBarrier& barrier,
+              const int64_t& park_nanos)
+    {
+        stdext::unique_lock<stdext::mutex> ulock(mutex_);
+        waiters_.fetch_add(1);
+        stdext::atomic_thread_fence(stdext::memory_order_seq_cst);
+        if (cursor.get() < sequence && !barrier.isAlerted()) {
+            int64_t park_start_nanos = WaitClock::nanoTime();
+            if (consumer_notify_condition_.wait_for(ulock,
+                        stdext::chrono::nanoseconds(park_nanos))
+                    == stdext::cv_status::no_timeout) {
+                int64_t signal_nanos =
+                    signal_nanos_.load(stdext::memory_order_relaxed);
+                if (signal_nanos >= park_start_nanos) {
+                    park_latency_nanos_.store(average(
+                            park_latency_nanos_.load(
+                                stdext::memory_order_relaxed),
+                            WaitClock::nanoTime() - signal_nanos),
+                        stdext::memory_order_relaxed);
+                }
+            }
+        }
+        waiters_.fetch_sub(1);
+    }
+
+    // Record a wait, the statistics are shared by the consumers and updated
+    // without locking, a lost update only delays the tuning.
+    void record(const int64_t& gap_nanos, const int64_t& now_nanos)
+    {
+        average_gap_nanos_.store(average(
+                average_gap_nanos_.load(stdext::memory_order_relaxed),
+                gap_nanos), stdext::memory_order_relaxed);
+        window_wait_nanos_.fetch_add(gap_nanos, stdext::memory_order_relaxed);
+
+        int64_t window_start_nanos =
+            window_start_nanos_.load(stdext::memory_order_relaxed);
+        int64_t window_nanos = now_nanos - window_start_nanos;
+        if (window_waits_.fetch_add(1, stdext::memory_order_relaxed) + 1 <
+                kTuneWaits && window_nanos < kTuneWindowNanos) {
+            return;
+        }
+        // a single consumer retunes per window
+        if (window_nanos <= 0 || !window_start_nanos_.compare_exchange_strong(
+                    window_start_nanos, now_nanos)) {
+            return;
+        }
+
+        window_waits_.store(0, stdext::memory_order_relaxed);
+        double idle_fraction = static_cast<double>(window_wait_nanos_.exchange(
+                    0, stdext::memory_order_relaxed)) / window_nanos;
+        retune(std::min(1.0, idle_fraction));
+    }
+
+    void retune(const double& idle_fraction)
+    {
+        idle_permille_.store(static_cast<int>(idle_fraction * 1000),
+                             stdext::memory_order_relaxed);
+
+        int64_t gap_nanos = std::max<int64_t>(1,
+                average_gap_nanos_.load(stdext::memory_order_relaxed));
+        int64_t park_latency_nanos =
+            park_latency_nanos_.load(stdext::memory_order_relaxed);
+        int64_t backoff_nanos = 0;
+        if (park_latency_nanos > budget_nanos_) {
+            double backoff = gap_nanos * std::log(
+                    static_cast<double>(park_latency_nanos) / budget_nanos_);
+            backoff_nanos = backoff < kMaxBackoffNanos ?
+                static_cast<int64_t>(backoff) : kMaxBackoffNanos;
+        }
+
+        spin_nanos_.store(static_cast<int64_t>(
+                    backoff_nanos * (1.0 - idle_fraction)),
+                stdext::memory_order_relaxed);
+        backoff_nanos_.store(backoff_nanos, stdext::memory_order_relaxed);
+    }
+
+    // Exponential moving average weighting the new sample by 1/8.
+    static int64_t average(const int64_t& average, const int64_t& sample)
+    {
+        return average + (sample - average) / 8;
+    }
+
+    const int64_t budget_nanos_;
+    stdext::atomic<int> phase_;
+    stdext::atomic<int64_t> spin_nanos_;
+    stdext::atomic<int64_t> backoff_nanos_;
+    stdext::atomic<int64_t> average_gap_nanos_;
+    stdext::atomic<int64_t> park_latency_nanos_;
+    stdext::atomic<int> idle_permille_;
+    stdext::atomic<int64_t> window_start_nanos_;
+    stdext::atomic<int64_t> window_wait_nanos_;
+    stdext::atomic<int> window_waits_;
+    stdext::atomic<int64_t> signal_nanos_;
+    stdext::atomic<int> waiters_;
+    stdext::mutex mutex_;
+    stdext::condition_variable consumer_notify_condition_;
+};
+
+#ifdef __linux__
+// Spin then park strategy for {@link EventProcessor}s waiting on a barrier.
+//
+// The consumer spins on the cursor for spin_time, then parks on a futex word.
+// Publishers bump the word and wake the futex only when a consumer is
+// parked, so a busy consumer costs them a fence and a load per publish.
+class FutexStrategy : public IWaitStrategy
+{
+public:
+    FutexStrategy()
+        : spin_time_(stdext::chrono::microseconds(10))
+        , futex_(0)
+        , waiters_(0)
+    {
+    }
+
+    FutexStrategy(const stdext::chrono::microseconds& spin_time)
+        : spin_time_(spin_time)
+        , futex_(0)
+        , waiters_(0)
+    {
+    }
+
+    virtual int64_t waitFor(const int64_t& sequence,
+                            const Sequence& cursor,
+                            const DependentSequences& dependents,
+                            const ISequenceBarrier& barrier)
+    {
+        return waitUntil(sequence, cursor, dependents, barrier, NULL);
+    }
+
+    virtual int64_t waitFor(const int64_t& sequence,
+                            const Sequence& cursor,
+                            const DependentSequences& dependents,
+                            const ISequenceBarrier& barrier,
+                            const stdext::chrono::microseconds& timeout)
+    {
+        Deadline deadline(timeout, 1);
+        return waitUntil(sequence, cursor, dependents, barrier, &deadline);
+    }
+
+    virtual void signalAllWhenBlocking()
+    {
+        // pairs with the fence of the waiters so either the publisher sees
+        // the waiter, or the waiter sees the moved cursor
+        stdext::atomic_thread_fence(stdext::memory_order_seq_cst);
+        if (waiters_.load(stdext::memory_order_relaxed) != 0) {
+            futex_.fetch_add(1, stdext::memory_order_release);
+            syscall(SYS_futex, futexWord(), FUTEX_WAKE_PRIVATE, INT_MAX,
+                    NULL, NULL, 0);
+        }
+    }
+
+private:
+    static const int kSpinsPerClockCheck = 64;
+
+    int64_t waitUntil(const int64_t& sequence,
+                      const Sequence& cursor,
+                      const DependentSequences& dependents,
+                      const ISequenceBarrier& barrier,
+                      const Deadline* deadline)
+    {
+        int64_t available_sequence = 0;
+        if ((available_sequence = cursor.get()) < sequence) {
+            Deadline spin_deadline(spin_time_, kSpinsPerClockCheck);
+            SpinBackoff backoff;
+            while ((available_sequence = cursor.get()) < sequence) {
+                barrier.checkAlert();
+                backoff.pause();
+                if (spin_deadline.expired()) {
+                    break;
+                }
+            }
+        }
+
+        if (available_sequence < sequence) {
+            waiters_.fetch_add(1);
+            stdext::atomic_thread_fence(stdext::memory_order_seq_cst);
+            while (true) {
+                // read the word before the cursor, a publish in between
+                // changes the word and the futex wait returns at once
+                int32_t word = futex_.load(stdext::memory_order_acquire);
+                if ((available_sequence = cursor.get()) >= sequence ||
+                        barrier.isAlerted() || !park(word, deadline)) {
+                    break;
+                }
+            }
+            waiters_.fetch_sub(1);
+            barrier.checkAlert();
+        }
+
+        if (0 != dependents.size()) {
+            SpinBackoff backoff;
+            while ((available_sequence
+                        = getMinimumSequence(dependents)) < sequence) {
+                barrier.checkAlert();
+                backoff.pause();
+            }
+        }
+
+        return available_sequence;
+    }
+
+    // @return false once the deadline has passed.
+    bool park(int32_t word, const Deadline* deadline)
+    {
+        struct timespec timeout;
+        if (deadline != NULL && !deadline->remaining(timeout)) {
+            return false;
+        }
+        if (syscall(SYS_futex, futexWord(), FUTEX_WAIT_PRIVATE, word,
+                    deadline != NULL ? &timeout : NULL, NULL, 0) == -1 &&
+                errno == ETIMEDOUT) {
+            return false;
+        }
+        return true;
+    }
+
+    int32_t* futexWord()
+    {
+        return reinterpret_cast<int32_t*>(&futex_);
+    }
+
+    stdext::chrono::microseconds spin_time_;
+    stdext::atomic<int32_t> futex_;
+    stdext::atomic<int> waiters_;
 };
 
+// Strategy parking {@link EventProcessor}s on eventfds, one per barrier
+// waiting on it, so several consumers can share the strategy.
+//
+// Publishers only write the eventfd of a consumer once it has declared
+// itself idle, and only once per idle period, so wake-ups are coalesced and
+// busy consumers cost them a fence and a load per publish. A consumer only
+// ever resets its own eventfd, so it cannot swallow the wake-up of another.
+//
+// The descriptor can be registered in an external epoll set, for a thread
+// waiting on both a {@link RingBuffer} and sockets:
+//
+//   strategy.markIdle(*barrier);
+//   if (nothing to poll from the ring) {
+//       epoll_wait(...);  // wakes up when getFd(*barrier) is readable
+//   }
+//   strategy.markBusy(*barrier);
+class EventFdStrategy : public IWaitStrategy
+{
+public:
+    // Maximum number of barriers waiting on one strategy at a time.
+    static const int kMaxWaiters = 64;
+
+    EventFdStrategy()
+        : waiter_count_(0)
+        , idle_count_(0)
+    {
+        for (int i = 0; i < kMaxWaiters; ++i) {
+            waiters_[i].barrier.store(NULL, stdext::memory_order_relaxed);
+            waiters_[i].fd = -1;
+            waiters_[i].state.store(kBusy, stdext::memory_order_relaxed);
+        }
+    }
+
+    virtual ~EventFdStrategy()
+    {
+        const int count = waiter_count_.load(stdext::memory_order_acquire);
+        for (int i = 0; i < count; ++i) {
+            if (waiters_[i].fd != -1) {
+                close(waiters_[i].fd);
+            }
+        }
+    }
+
+    // @param barrier the barrier the consumer waits on.
+    // @return the eventfd of the consumer, readable once events are
+    // published after {@link #markIdle()}.
+    int getFd(const ISequenceBarrier& barrier)
+    {
+        return waiter(barrier).fd;
+    }
+
+    // Declare the consumer idle, so the next publish writes its eventfd.
+    // The ring must be checked again after this call and before waiting on
+    // the descriptor, otherwise an event published just before may be
+    // missed.
+    //
+    // @param barrier the barrier the consumer waits on.
+    void markIdle(const ISequenceBarrier& barrier)
+    {
+        markIdle(waiter(barrier));
+    }
+
+    // Declare the consumer busy again and reset its eventfd.
+    //
+    // @param barrier the barrier the consumer waits on.
+    void markBusy(const ISequenceBarrier& barrier)
+    {
+        markBusy(waiter(barrier));
+    }
+
+    virtual int64_t waitFor(const int64_t& sequence,
+                            const Sequence& cursor,
+                            const DependentSequences& dependents,
+                            const ISequenceBarrier& barrier)
+    {
+        return waitUntil(sequence, cursor, dependents, barrier, NULL);
+    }
+
+    virtual int64_t waitFor(const int64_t& sequence,
+                            const Sequence& cursor,
+                            const DependentSequences& dependents,
+                            const ISequenceBarrier& barrier,
+                            const stdext::chrono::microseconds& timeout)
+    {
+        Deadline deadline(timeout, 1);
+        return waitUntil(sequence, cursor, dependents, barrier, &deadline);
+    }
+
+    virtual void signalAllWhenBlocking()
+    {
+        // pairs with the fence of the consumers so either the publisher
+        // sees the consumer idle, or the consumer sees the moved cursor
+        stdext::atomic_thread_fence(stdext::memory_order_seq_cst);
+        if (idle_count_.load(stdext::memory_order_relaxed) == 0) {
+            return;
+        }
+        const int count = waiter_count_.load(stdext::memory_order_acquire);
+        for (int i = 0; i < count; ++i) {
+            Waiter& waiter = waiters_[i];
+            int expected = kIdle;
+            if (waiter.state.load(stdext::memory_order_relaxed) == kIdle &&
+                    waiter.state.compare_exchange_strong(expected,
+                        kSignalling)) {
+                idle_count_.fetch_sub(1, stdext::memory_order_relaxed);
+                eventfd_write(waiter.fd, 1);
+                // the consumer may have gone idle again meanwhile
+                expected = kSignalling;
+                waiter.state.compare_exchange_strong(expected, kBusy);
+            }
+        }
+    }
+
+    // Create the eventfd of a barrier, in a slot released by a destroyed
+    // barrier if there is one.
+    //
+    // @throws std::length_error if kMaxWaiters barriers are registered.
+    // @throws std::runtime_error if the eventfd can not be created.
+    virtual void registerBarrier(const ISequenceBarrier& barrier)
+    {
+        stdext::lock_guard<stdext::mutex> lock(mutex_);
+        const int count = waiter_count_.load(stdext::memory_order_relaxed);
+        int slot = 0;
+        while (slot < count &&
+                waiters_[slot].barrier.load(stdext::memory_order_relaxed)
+                    != NULL) {
+            ++slot;
+        }
+        if (slot == kMaxWaiters) {
+            throw std::length_error(
+                    "Too many barriers waiting on an EventFdStrategy");
+        }
+        int fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (fd == -1) {
+            throw std::runtime_error("Failed to create eventfd");
+        }
+        waiters_[slot].fd = fd;
+        waiters_[slot].barrier.store(&barrier, stdext::memory_order_release);
+        if (slot == count) {
+            // publishers only look at the slots below the count
+            waiter_count_.store(count + 1, stdext::memory_order_release);
+        }
+    }
+
+    // Close the eventfd of a barrier and release its slot. Its consumer is
+    // gone and busy, the publisher still writing to the eventfd, if any, is
+    // waited for.
+    virtual void unregisterBarrier(const ISequenceBarrier& barrier)
+    {
+        stdext::lock_guard<stdext::mutex> lock(mutex_);
+        Waiter* waiter = find(barrier);
+        if (waiter == NULL) {
+            return;
+        }
+        while (waiter->state.load(stdext::memory_order_acquire)
+                == kSignalling) {
+            stdext::this_thread::yield();
+        }
+        close(waiter->fd);
+        waiter->fd = -1;
+        waiter->barrier.store(NULL, stdext::memory_order_release);
+    }
+
+private:
+    EventFdStrategy(const EventFdStrategy&);
+    EventFdStrategy& operator= (EventFdStrategy);
+
+    // States of a consumer, a publisher moves an idle consumer to
+    // signalling for as long as it writes its eventfd.
+    enum WaiterState {
+        kBusy,
+        kIdle,
+        kSignalling
+    };
+
+    struct Waiter
+    {
+        stdext::atomic<const ISequenceBarrier*> barrier;
+        int fd;
+        stdext::atomic<int> state;
+    };
+
+    int64_t waitUntil(const int64_t& sequence,
+                      const Sequence& cursor,
+                      const DependentSequences& dependents,
+                      const ISequenceBarrier& barrier,
+                      const Deadline* deadline)
+    {
+        int64_t available_sequence = 0;
+        if ((available_sequence = cursor.get()) < sequence) {
+            Waiter& waiter = this->waiter(barrier);
+            while ((available_sequence = cursor.get()) < sequence) {
+                barrier.checkAlert();
+                markIdle(waiter);
+                if ((available_sequence = cursor.get()) >= sequence) {
+                    markBusy(waiter);
+                    break;
+                }
+                bool timed_out = !park(waiter, deadline);
+                markBusy(waiter);
+                if (timed_out) {
+                    available_sequence = cursor.get();
+                    break;
+                }
+            }
+        }
+
+        if (0 != dependents.size()) {
+            SpinBackoff backoff;
+            while ((available_sequence
+                        = getMinimumSequence(dependents)) < sequence) {
+                barrier.checkAlert();
+                backoff.pause();
+            }
+        }
+
+        return available_sequence;
+    }
+
+    void markIdle(Waiter& waiter)
+    {
+        waiter.state.store(kIdle, stdext::memory_order_release);
+        idle_count_.fetch_add(1, stdext::memory_order_relaxed);
+        stdext::atomic_thread_fence(stdext::memory_order_seq_cst);
+    }
+
+    void markBusy(Waiter& waiter)
+    {
+        int expected = kIdle;
+        if (waiter.state.compare_exchange_strong(expected, kBusy)) {
+            idle_count_.fetch_sub(1, stdext::memory_order_relaxed);
+        }
+        eventfd_t value;
+        eventfd_read(waiter.fd, &value);
+    }
+
+    // @return false once the deadline has passed.
+    bool park(const Waiter& waiter, const Deadline* deadline)
+    {
+        struct timespec timeout;
+        if (deadline != NULL && !deadline->remaining(timeout)) {
+            return false;
+        }
+        struct pollfd poll_fd;
+        poll_fd.fd = waiter.fd;
+        poll_fd.events = POLLIN;
+        return ppoll(&poll_fd, 1, deadline != NULL ? &timeout : NULL,
+                     NULL) != 0;
+    }
+
+    // @return the slot of a barrier, NULL if it is not registered.
+    Waiter* find(const ISequenceBarrier& barrier)
+    {
+        const int count = waiter_count_.load(stdext::memory_order_acquire);
+        for (int i = 0; i < count; ++i) {
+            if (waiters_[i].barrier.load(stdext::memory_order_acquire)
+                    == &barrier) {
+                return &waiters_[i];
+            }
+        }
+        return NULL;
+    }
+
+    // @throws std::logic_error if the barrier was not created by a
+    // {@link Sequencer} waiting with this strategy.
+    Waiter& waiter(const ISequenceBarrier& barrier)
+    {
+        Waiter* waiter = find(barrier);
+        if (waiter == NULL) {
+            throw std::logic_error(
+                    "Barrier not registered with the EventFdStrategy");
+        }
+        return *waiter;
+    }
+
+    Waiter waiters_[kMaxWaiters];
+    // slots in use or released, publishers only look at the slots below
+    stdext::atomic<int> waiter_count_;
+    // number of consumers idle, so publishers skip the slots while all of
+    // them are busy
+    stdext::atomic<int> idle_count_;
+    // serialises the registrations
+    stdext::mutex mutex_;
+};
+#endif
+
 
 inline WaitStrategyPtr createWaitStrategy(WaitStrategyOption wait_option,
                                           const TimeConfig& timeConfig)
@@ -378,11 +1393,130 @@ inline WaitStrategyPtr createWaitStrategy(WaitStrategyOption wait_option,
             return stdext::make_shared<YieldingStrategy>();
         case kBusySpinStrategy:
             return stdext::make_shared<BusySpinStrategy>();
+        case kLiteBlockingStrategy:
+            return stdext::make_shared<LiteBlockingStrategy>();
+        case kPausingBusySpinStrategy:
+            return stdext::make_shared<PausingBusySpinStrategy>();
+        case kPhasedBackoffBlockingStrategy:
+            return stdext::make_shared<PhasedBackoffStrategy>(
+                    getTimeConfig(timeConfig, kSpin,
+                        stdext::chrono::microseconds(10)),
+                    getTimeConfig(timeConfig, kYield,
+                        stdext::chrono::microseconds(100)),
+                    stdext::make_shared<BlockingStrategy>());
+        case kPhasedBackoffLiteBlockingStrategy:
+            return stdext::make_shared<PhasedBackoffStrategy>(
+                    getTimeConfig(timeConfig, kSpin,
+                        stdext::chrono::microseconds(10)),
+                    getTimeConfig(timeConfig, kYield,
+                        stdext::chrono::microseconds(100)),
+                    stdext::make_shared<LiteBlockingStrategy>());
+        case kPhasedBackoffSleepingStrategy:
+            return stdext::make_shared<PhasedBackoffStrategy>(
+                    getTimeConfig(timeConfig, kSpin,
+                        stdext::chrono::microseconds(10)),
+                    getTimeConfig(timeConfig, kYield,
+                        stdext::chrono::microseconds(100)),
+                    stdext::make_shared<SleepingStrategy>(
+                        getTimeConfig(timeConfig, kSleep,
+                            stdext::chrono::milliseconds(1))));
+        case kAdaptiveStrategy:
+            return stdext::make_shared<AdaptiveStrategy>(
+                    getTimeConfig(timeConfig, kLatencyBudget,
+                        stdext::chrono::microseconds(50)));
+#ifdef __linux__
+        case kFutexStrategy:
+            return stdext::make_shared<FutexStrategy>(
+                    getTimeConfig(timeConfig, kSpin,
+                        stdext::chrono::microseconds(10)));
+        case kEventFdStrategy:
+            return stdext::make_shared<EventFdStrategy>();
+#endif
         default:
             return WaitStrategyPtr();
     }
 }
 
+// Wait strategy selected at run time from a {@link WaitStrategyOption}.
+//
+// This is the wait policy of the option based {@link Sequencer}, every call
+// is forwarded through the {@link IWaitStrategy} interface. Use one of the
+// concrete strategies as the policy instead to have the calls inlined.
+class RuntimeWaitStrategy
+{
+public:
+    // Construct the default strategy, {@link BlockingStrategy}.
+    RuntimeWaitStrategy()
+        : wait_strategy_(createWaitStrategy(kBlockingStrategy, TimeConfig()))
+        , is_blocking_(wait_strategy_->isBlocking())
+    {
+    }
+
+    RuntimeWaitStrategy(WaitStrategyOption option,
+                        const TimeConfig& timeConfig)
+        : wait_strategy_(createWaitStrategy(option, timeConfig))
+        , is_blocking_(wait_strategy_ && wait_strategy_->isBlocking())
+    {
+    }
+
+    // Wrap a strategy created by the caller, e.g. a shared
+    // {@link AdaptiveStrategy} to monitor.
+    explicit RuntimeWaitStrategy(const WaitStrategyPtr& wait_strategy)
+        : wait_strategy_(wait_strategy)
+        , is_blocking_(wait_strategy_ && wait_strategy_->isBlocking())
+    {
+    }
+
+    int64_t waitFor(const int64_t& sequence,
+                    const Sequence& cursor,
+                    const DependentSequences& dependents,
+                    const ISequenceBarrier& barrier)
+    {
+        return wait_strategy_->waitFor(sequence, cursor, dependents, barrier);
+    }
+
+    int64_t waitFor(const int64_t& sequence,
+                    const Sequence& cursor,
+                    const DependentSequences& dependents,
+                    const ISequenceBarrier& barrier,
+                    const stdext::chrono::microseconds& timeout)
+    {
+        return wait_strategy_->waitFor(sequence, cursor, dependents, barrier,
+                                       timeout);
+    }
+
+    void signalAllWhenBlocking()
+    {
+        if (is_blocking_) {
+            wait_strategy_->signalAllWhenBlocking();
+        }
+    }
+
+    bool isBlocking() const { return is_blocking_; }
+
+    void registerBarrier(const ISequenceBarrier& barrier)
+    {
+        wait_strategy_->registerBarrier(barrier);
+    }
+
+    void unregisterBarrier(const ISequenceBarrier& barrier)
+    {
+        wait_strategy_->unregisterBarrier(barrier);
+    }
+
+    // @return the selected strategy, e.g. to get the descriptor of an
+    // {@link EventFdStrategy}.
+    IWaitStrategy* get() const { return wait_strategy_.get(); }
+
+private:
+    RuntimeWaitStrategy(const RuntimeWaitStrategy&);
+    RuntimeWaitStrategy& operator= (RuntimeWaitStrategy);
+
+    WaitStrategyPtr wait_strategy_;
+    // cached to skip the virtual call of the strategies that never block
+    const bool is_blocking_;
+};
+
 
 }
 
@@ -0,0 +1,166 @@
+#ifndef DISRUPTOR_WORK_PROCESSOR_H_
+#define DISRUPTOR_WORK_PROCESSOR_H_
+
+#include <disruptor/ring_buffer.h>
+
+
+namespace disruptor {
+
+
+// A {@link WorkProcessor} wraps a single {@link WorkHandler}, effectively
+// consuming the sequence and ensuring appropriate barriers.
+//
+// Sequences are claimed from a work {@link Sequence} shared with the other
+// processors of a {@link WorkerPool}, so each event is handed to exactly one
+// {@link WorkHandler}. Sequences are claimed claim_batch_size at a time to
+// limit contention on the shared work {@link Sequence}.
+//
+// @param <T> event implementation storing the data for sharing during
+// exchange or parallel coordination of an event.
+// @param <RingBufferType> the {@link RingBuffer} instance consumed from.
+template <typename T, typename RingBufferType = RingBuffer<T> >
+class WorkProcessor : public IEventProcessor<T>
+{
+public:
+    typedef typename RingBufferType::barrier_type barrier_type;
+
+    // Construct a {@link WorkProcessor}.
+    //
+    // @param ring_buffer to which events are published.
+    // @param sequence_barrier on which it is waiting.
+    // @param work_handler is the delegate to which events are dispatched.
+    // @param exception_handler to be called back when an error occurs.
+    // @param work_sequence from which to claim the next event to be worked
+    // on, shared by all the processors of the {@link WorkerPool}.
+    // @param max_idle_time after which the wait for events is retried.
+    // @param claim_batch_size number of sequences claimed at a time.
+    WorkProcessor(RingBufferType* ring_buffer,
+                  stdext::shared_ptr<barrier_type> sequence_barrier,
+                  IWorkHandler<T>* work_handler,
+                  IExceptionHandler<T>* exception_handler,
+                  Sequence* work_sequence,
+                  const stdext::chrono::microseconds& max_idle_time,
+                  const int& claim_batch_size = 1)
+        : running_(false)
+        , ring_buffer_(ring_buffer)
+        , sequence_barrier_(sequence_barrier)
+        , work_handler_(work_handler)
+        , exception_handler_(exception_handler)
+        , work_sequence_(work_sequence)
+        , wait_(max_idle_time)
+        , claim_batch_size_(claim_batch_size)
+    {
+        if (claim_batch_size < 1 ||
+                claim_batch_size > ring_buffer->capacity()) {
+            throw std::invalid_argument(
+                    "claim_batch_size must be > 0 and <= buffer size");
+        }
+    }
+
+    virtual Sequence* getSequence() { return &sequence_; }
+
+    virtual void halt();
+
+    void operator() () { run(); }
+
+protected:
+    virtual void run();
+
+private:
+    WorkProcessor(const WorkProcessor& w);
+    WorkProcessor& operator= (WorkProcessor w);
+
+    stdext::atomic<bool>         running_;
+    Sequence                     sequence_;
+    RingBufferType*              ring_buffer_;
+    stdext::shared_ptr<barrier_type> sequence_barrier_;
+    IWorkHandler<T>*             work_handler_;
+    IExceptionHandler<T>*        exception_handler_;
+    Sequence*                    work_sequence_;
+    stdext::chrono::microseconds wait_;
+    const int                    claim_batch_size_;
+};
+
+
+//
+// implementation
+//
+
+template <typename T, typename RingBufferType>
+void WorkProcessor<T, RingBufferType>::halt()
+{
+    running_.store(false);
+    sequence_barrier_->alert();
+}
+
+
+template <typename T, typename RingBufferType>
+void WorkProcessor<T, RingBufferType>::run()
+{
+    bool expected = false;
+    if (!running_.compare_exchange_strong(expected, true)) {
+        throw std::runtime_error("Thread is already running");
+    }
+
+    work_handler_->onStart();
+
+    T* event = NULL;
+    int64_t next_sequence = 0;
+    int64_t last_claimed = -1;
+    int64_t cached_available_sequence = LONG_MIN;
+
+    while (true) {
+        try {
+            if (next_sequence > last_claimed) {
+                // our own sequence is moved up before the claim so that the
+                // publishers are never gated beyond what is left to consume
+                int64_t work_sequence;
+                do {
+                    work_sequence = work_sequence_->get();
+                    sequence_.set(work_sequence);
+                } while (!work_sequence_->compareAndExchange(work_sequence,
+                            work_sequence + claim_batch_size_));
+
+                next_sequence = work_sequence + 1L;
+                last_claimed = work_sequence + claim_batch_size_;
+            }
+
+            if (cached_available_sequence < next_sequence) {
+                cached_available_sequence =
+                    sequence_barrier_->barrier_type::waitFor(next_sequence,
+                                                             wait_);
+                if (cached_available_sequence < next_sequence) {
+                    continue;
+                }
+            }
+
+            int64_t last_sequence = cached_available_sequence < last_claimed ?
+                cached_available_sequence : last_claimed;
+
+            while (next_sequence <= last_sequence) {
+                event = ring_buffer_->get(next_sequence);
+                work_handler_->onEvent(next_sequence, event);
+                next_sequence++;
+            }
+
+            sequence_.set(last_sequence);
+            sequence_barrier_->barrier_type::signalProducers();
+        }
+        catch(const AlertException& e) {
+            break;
+        }
+        catch(const std::exception& e) {
+            if (exception_handler_) {
+                exception_handler_->handle(e, next_sequence, event);
+            }
+            next_sequence++;
+        }
+    }
+
+    work_handler_->onShutdown();
+    running_.store(false);
+}
+
+}
+
+#endif
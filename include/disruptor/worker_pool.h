@@ -0,0 +1,150 @@
+#ifndef DISRUPTOR_WORKER_POOL_H_
+#define DISRUPTOR_WORKER_POOL_H_
+
+#include <vector>
+
+#include <disruptor/work_processor.h>
+
+
+namespace disruptor {
+
+
+// A pool of {@link WorkProcessor}s that will consume sequences so jobs can
+// be farmed out across a pool of workers, each event being handled by
+// exactly one {@link WorkHandler}.
+//
+// The publishers must be gated on {@link #getWorkerSequences()}.
+//
+// @param <T> event implementation storing the data for sharing during
+// exchange or parallel coordination of an event.
+// @param <RingBufferType> the {@link RingBuffer} instance consumed from.
+template <typename T, typename RingBufferType = RingBuffer<T> >
+class WorkerPool
+{
+public:
+    typedef WorkProcessor<T, RingBufferType> processor_type;
+    typedef typename RingBufferType::barrier_type barrier_type;
+
+    // Create a worker pool with one {@link WorkProcessor} per
+    // {@link WorkHandler}, all waiting on the same barrier.
+    //
+    // @param ring_buffer of events to be consumed.
+    // @param sequence_barrier on which the workers will depend.
+    // @param work_handlers to distribute the work load across.
+    // @param exception_handler to callback when an error occurs which is not
+    // handled by the {@link WorkHandler}s.
+    // @param max_idle_time after which the workers retry waiting for events.
+    // @param claim_batch_size number of sequences a worker claims at a time.
+    WorkerPool(RingBufferType* ring_buffer,
+               stdext::shared_ptr<barrier_type> sequence_barrier,
+               const std::vector<IWorkHandler<T>*>& work_handlers,
+               IExceptionHandler<T>* exception_handler,
+               const stdext::chrono::microseconds& max_idle_time,
+               const int& claim_batch_size = 1)
+        : ring_buffer_(ring_buffer)
+        , sequence_barrier_(sequence_barrier)
+        , started_(false)
+    {
+        for (size_t i = 0; i < work_handlers.size(); ++i) {
+            processors_.push_back(stdext::shared_ptr<processor_type>(
+                        new processor_type(ring_buffer, sequence_barrier,
+                            work_handlers[i], exception_handler,
+                            &work_sequence_, max_idle_time,
+                            claim_batch_size)));
+        }
+    }
+
+    ~WorkerPool()
+    {
+        if (started_) {
+            halt();
+        }
+    }
+
+    // Get the sequences of the workers and of the shared work sequence, the
+    // publishers should be gated on these through
+    // {@link Sequencer#setGatingSequences()}.
+    //
+    // @return the sequences to gate the publishers on.
+    DependentSequences getWorkerSequences()
+    {
+        DependentSequences sequences;
+        sequences.reserve(processors_.size() + 1);
+        for (size_t i = 0; i < processors_.size(); ++i) {
+            sequences.push_back(processors_[i]->getSequence());
+        }
+        sequences.push_back(&work_sequence_);
+
+        return sequences;
+    }
+
+    // Start the worker pool processing events in sequence, from the current
+    // cursor of the {@link RingBuffer}, with one thread per worker. A pool
+    // halted before can be started again.
+    //
+    // @throws std::runtime_error if the pool has already been started.
+    void start()
+    {
+        if (started_) {
+            throw std::runtime_error("WorkerPool has already been started");
+        }
+        started_ = true;
+
+        // the alert of a previous halt would stop the workers straight away,
+        // none of them is running yet so it can be cleared here
+        sequence_barrier_->clearAlert();
+
+        int64_t cursor = ring_buffer_->getCursor();
+        work_sequence_.set(cursor);
+
+        for (size_t i = 0; i < processors_.size(); ++i) {
+            processors_[i]->getSequence()->set(cursor);
+            threads_.push_back(stdext::shared_ptr<stdext::thread>(
+                        new stdext::thread(
+                            stdext::ref<processor_type>(*processors_[i]))));
+        }
+    }
+
+    // Wait for the {@link RingBuffer} to drain of published events then halt
+    // the workers.
+    void drainAndHalt()
+    {
+        DependentSequences sequences = getWorkerSequences();
+        while (ring_buffer_->getCursor() > getMinimumSequence(sequences)) {
+            stdext::this_thread::yield();
+        }
+
+        halt();
+    }
+
+    // Halt all workers immediately at the end of their current cycle and
+    // wait for their threads to exit.
+    void halt()
+    {
+        for (size_t i = 0; i < processors_.size(); ++i) {
+            processors_[i]->halt();
+        }
+        for (size_t i = 0; i < threads_.size(); ++i) {
+            threads_[i]->join();
+        }
+        threads_.clear();
+        started_ = false;
+    }
+
+    bool isRunning() const { return started_; }
+
+private:
+    WorkerPool(const WorkerPool& w);
+    WorkerPool& operator= (WorkerPool w);
+
+    RingBufferType*                                  ring_buffer_;
+    stdext::shared_ptr<barrier_type>                 sequence_barrier_;
+    Sequence                                         work_sequence_;
+    std::vector<stdext::shared_ptr<processor_type> > processors_;
+    std::vector<stdext::shared_ptr<stdext::thread> > threads_;
+    bool                                             started_;
+};
+
+}
+
+#endif
@@ -0,0 +1,118 @@
+#include <time.h>
+
+#include <iostream>
+#include <vector>
+
+#include <boost/ref.hpp>
+#include <boost/thread.hpp>
+
+#include <disruptor/event_processor.h>
+#include <disruptor/ring_buffer.h>
+
+#include <gtest/gtest.h>
+
+namespace disruptor {
+namespace test {
+
+static const uint64_t ONE_SEC_IN_NANO = 1000UL * 1000UL * 1000UL;
+static const int BUFFER_SIZE = 1024 * 8;
+
+struct ValueEvent
+{
+    int64_t value;
+};
+
+class SummingHandler : public IEventHandler<ValueEvent>
+{
+public:
+    SummingHandler() : sum_(0) {}
+
+    virtual void onEvent(const int64_t& sequence,
+                         const int64_t& batch_size,
+                         const bool& end_of_batch,
+                         ValueEvent* event)
+    {
+        if (event != NULL) {
+            sum_ += event->value;
+        }
+    }
+
+    virtual void onStart() {}
+
+    virtual void onShutdown() {}
+
+    int64_t sum() const { return sum_; }
+
+private:
+    int64_t sum_;
+};
+
+template <typename WaitStrategy>
+class BlockingStrategyTest : public ::testing::Test
+{
+};
+
+typedef ::testing::Types<
+        BlockingStrategy,
+        LiteBlockingStrategy,
+        AdaptiveStrategy
+#ifdef __linux__
+        , FutexStrategy
+#endif
+    > BlockingStrategyTypes;
+TYPED_TEST_CASE(BlockingStrategyTest, BlockingStrategyTypes);
+
+// One publisher and one processor, both as fast as they can go: the
+// processor is mostly busy, so the cost of signalling on each publish
+// dominates the publisher.
+TYPED_TEST(BlockingStrategyTest, PublishToBusyProcessor)
+{
+    typedef RingBuffer<ValueEvent, SingleThreadedStrategy, TypeParam>
+        RingBufferType;
+    const long iterations = 1000L * 1000L * 10;
+
+    RingBufferType ring_buffer(BUFFER_SIZE);
+    SummingHandler handler;
+    BatchEventProcessor<ValueEvent, RingBufferType> processor(&ring_buffer,
+            ring_buffer.newBarrier(std::vector<Sequence*>(0)),
+            &handler, NULL, stdext::chrono::milliseconds(1));
+    ring_buffer.setGatingSequences(
+            std::vector<Sequence*>(1, processor.getSequence()));
+    boost::thread consumer(
+            boost::ref< BatchEventProcessor<ValueEvent, RingBufferType> >(
+                processor));
+
+    struct timespec start_time, end_time;
+    // +----- start timer -----+
+    clock_gettime(CLOCK_MONOTONIC, &start_time);
+
+    for (long i = 0; i < iterations; ++i) {
+        int64_t sequence = ring_buffer.next();
+        ring_buffer.get(sequence)->value = i;
+        ring_buffer.publish(sequence);
+    }
+    while (processor.getSequence()->get() < iterations - 1) {
+        boost::this_thread::yield();
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &end_time);
+    // +----- stop timer -----+
+
+    processor.halt();
+    consumer.join();
+    EXPECT_EQ(iterations * (iterations - 1) / 2, handler.sum());
+
+    double start, end;
+    start = start_time.tv_sec + ((double) start_time.tv_nsec / (ONE_SEC_IN_NANO));
+    end = end_time.tv_sec + ((double) end_time.tv_nsec / (ONE_SEC_IN_NANO));
+    double duration = end - start;
+
+    std::cout.precision(15);
+    std::cout << "1-Publisher-1-Processor performance: ";
+    std::cout << (iterations * 1.0) / duration << " ops/secs" << std::endl;
+    std::cout << "duration = " << duration << " secs" << std::endl;
+    std::cout << "ns per op = " << duration * ONE_SEC_IN_NANO / iterations << std::endl;
+}
+
+}
+}
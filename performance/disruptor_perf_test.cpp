@@ -14,11 +14,15 @@ typedef ::testing::Types<
         MultiYielding<1>,
         MultiYielding<3>,
         MultiLowContentionYielding<3>,
+        MultiAvailabilityYielding<3>,
         MultiBusySpin<1>,
         MultiBusySpin<3>,
         MultiLowContentionBusySpin<3>,
+        MultiAvailabilityBusySpin<3>,
         DynamicSingleWith<1, kSleepingStrategy>,
-        DynamicSingleWith<1, kYieldingStrategy>
+        DynamicSingleWith<1, kYieldingStrategy>,
+        BatchPublishing<SingleYielding<1> >,
+        BatchPublishing<MultiYielding<3> >
     > DisruptorTypes;
 TYPED_TEST_CASE(DisruptorPerfFixture, DisruptorTypes);
 
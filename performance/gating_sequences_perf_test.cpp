@@ -0,0 +1,177 @@
+#include <time.h>
+
+#include <iostream>
+#include <vector>
+
+#include <boost/atomic.hpp>
+#include <boost/thread.hpp>
+
+#include <disruptor/gating_sequences.h>
+#include <disruptor/ring_buffer.h>
+
+#include <gtest/gtest.h>
+
+namespace disruptor {
+namespace test {
+
+static const uint64_t ONE_SEC_IN_NANO = 1000UL * 1000UL * 1000UL;
+static const int BUFFER_SIZE = 1024 * 8;
+static const long ITERATIONS = 1000L * 1000L * 5;
+
+struct ValueEvent
+{
+    int64_t value;
+};
+
+double now()
+{
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return time.tv_sec + ((double) time.tv_nsec / (ONE_SEC_IN_NANO));
+}
+
+// Wrap check reading every gating sequence, as the claim strategies did
+// before {@link GatingSequences}.
+class ScanGating
+{
+public:
+    explicit ScanGating(const DependentSequences& sequences)
+        : sequences_(sequences)
+    {
+    }
+
+    int64_t getMinimumSequence(const int64_t& required) const
+    {
+        return disruptor::getMinimumSequence(sequences_);
+    }
+
+private:
+    const DependentSequences sequences_;
+};
+
+// Consumers following the publisher, all their sequences written by one
+// thread so each of them keeps bouncing between the two cores.
+class Consumers
+{
+public:
+    Consumers(int count, const Sequence& cursor)
+        : sequences_(count)
+        , cursor_(cursor)
+        , running_(true)
+    {
+        for (int i = 0; i < count; ++i) {
+            dependents_.push_back(&sequences_[i]);
+        }
+    }
+
+    void run()
+    {
+        while (running_.load(boost::memory_order_acquire)) {
+            int64_t published = cursor_.get();
+            for (size_t i = 0; i < sequences_.size(); ++i) {
+                sequences_[i].set(published);
+            }
+        }
+    }
+
+    void halt() { running_.store(false, boost::memory_order_release); }
+
+    const DependentSequences& dependents() const { return dependents_; }
+
+private:
+    std::vector<Sequence> sequences_;
+    DependentSequences dependents_;
+    const Sequence& cursor_;
+    boost::atomic<bool> running_;
+};
+
+// Publisher claiming one slot at a time against consumers it only checks
+// when the cached minimum falls behind, as the single threaded claim
+// strategy does.
+//
+// @return the number of wrap checks which read the gating sequences.
+template <typename Gating>
+long publish(Sequence& cursor, const Gating& gating)
+{
+    long scans = 0;
+    int64_t min_gating_sequence = INITIAL_CURSOR_VALUE;
+    for (int64_t sequence = 0; sequence < ITERATIONS; ++sequence) {
+        int64_t wrap_point = sequence - BUFFER_SIZE;
+        while (wrap_point > min_gating_sequence) {
+            min_gating_sequence = gating.getMinimumSequence(wrap_point);
+            ++scans;
+        }
+        cursor.set(sequence);
+    }
+    return scans;
+}
+
+template <typename Gating>
+void runWrapCheck(const char* name, int consumer_count)
+{
+    Sequence cursor(INITIAL_CURSOR_VALUE);
+    Consumers consumers(consumer_count, cursor);
+    Gating gating(consumers.dependents());
+    boost::thread consumer_thread(&Consumers::run, &consumers);
+
+    double start = now();
+    long scans = publish(cursor, gating);
+    double duration = now() - start;
+
+    consumers.halt();
+    consumer_thread.join();
+
+    std::cout.precision(15);
+    std::cout << name << " " << consumer_count << " consumers: ";
+    std::cout << ITERATIONS / duration << " ops/secs, ";
+    std::cout << duration * ONE_SEC_IN_NANO / scans << " ns per check"
+        << std::endl;
+}
+
+class GatingSequencesPerfTest : public ::testing::TestWithParam<int>
+{
+};
+
+INSTANTIATE_TEST_CASE_P(ConsumerCounts, GatingSequencesPerfTest,
+        ::testing::Values(1, 2, 4, 8, 16, 32, 64));
+
+// The publisher runs a full buffer ahead of the consumers, so every wrap
+// check finds a sequence to read: the plain scan reads all of them, the
+// cached minimums only the groups that moved behind the wrap point.
+TEST_P(GatingSequencesPerfTest, WrapCheck)
+{
+    runWrapCheck<ScanGating>("scan", GetParam());
+    runWrapCheck<GatingSequences>("cached", GetParam());
+}
+
+// Publish through a {@link RingBuffer} gated on the consumer sequences,
+// the claim strategy going through the cached minimums.
+TEST_P(GatingSequencesPerfTest, PublishThroughRingBuffer)
+{
+    typedef RingBuffer<ValueEvent, SingleThreadedStrategy, BusySpinStrategy>
+        RingBufferType;
+    RingBufferType ring_buffer(BUFFER_SIZE);
+    Sequence cursor(INITIAL_CURSOR_VALUE);
+    Consumers consumers(GetParam(), cursor);
+    ring_buffer.setGatingSequences(consumers.dependents());
+    boost::thread consumer_thread(&Consumers::run, &consumers);
+
+    double start = now();
+    for (long i = 0; i < ITERATIONS; ++i) {
+        int64_t sequence = ring_buffer.next();
+        ring_buffer.get(sequence)->value = i;
+        ring_buffer.publish(sequence);
+        cursor.set(sequence);
+    }
+    double duration = now() - start;
+
+    consumers.halt();
+    consumer_thread.join();
+
+    std::cout.precision(15);
+    std::cout << GetParam() << " consumers: ";
+    std::cout << ITERATIONS / duration << " ops/secs" << std::endl;
+}
+
+}
+}
@@ -0,0 +1,144 @@
+#include <time.h>
+
+#include <iostream>
+#include <vector>
+
+#include <boost/ref.hpp>
+#include <boost/thread.hpp>
+
+#include <disruptor/event_processor.h>
+#include <disruptor/ring_buffer.h>
+
+#include <gtest/gtest.h>
+
+namespace disruptor {
+namespace test {
+
+static const uint64_t ONE_SEC_IN_NANO = 1000UL * 1000UL * 1000UL;
+static const int BUFFER_SIZE = 1024 * 4;
+static const long ITERATIONS = 1000L * 1000L * 10;
+static const int WORDS_PER_LINE = CACHE_LINE_SIZE_IN_BYTES / sizeof(int64_t);
+
+// Event of N bytes, written and read one word per cache line so every line
+// of the slot moves from the publisher's core to the processor's.
+template <int N>
+struct PaddedEvent
+{
+    static const int WORDS = N / sizeof(int64_t);
+
+    void write(int64_t value)
+    {
+        for (int i = 0; i < WORDS; i += WORDS_PER_LINE) {
+            words[i] = value;
+        }
+    }
+
+    int64_t read() const
+    {
+        int64_t sum = 0;
+        for (int i = 0; i < WORDS; i += WORDS_PER_LINE) {
+            sum += words[i];
+        }
+        return sum;
+    }
+
+    int64_t words[WORDS];
+};
+
+template <typename Event>
+class ReadingHandler : public IEventHandler<Event>
+{
+public:
+    ReadingHandler() : sum_(0) {}
+
+    virtual void onEvent(const int64_t& sequence,
+                         const int64_t& batch_size,
+                         const bool& end_of_batch,
+                         Event* event)
+    {
+        if (event != NULL) {
+            sum_ += event->read();
+        }
+    }
+
+    virtual void onStart() {}
+
+    virtual void onShutdown() {}
+
+    int64_t sum() const { return sum_; }
+
+private:
+    int64_t sum_;
+};
+
+template <typename Event>
+class PrefetchTest : public ::testing::Test
+{
+};
+
+typedef ::testing::Types<
+        PaddedEvent<64>,
+        PaddedEvent<128>,
+        PaddedEvent<256>,
+        PaddedEvent<512>,
+        PaddedEvent<1024>,
+        PaddedEvent<2048>
+    > PrefetchEventTypes;
+TYPED_TEST_CASE(PrefetchTest, PrefetchEventTypes);
+
+double now()
+{
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return time.tv_sec + ((double) time.tv_nsec / (ONE_SEC_IN_NANO));
+}
+
+// One publisher and one processor reading every line of each event, for
+// a range of prefetch distances. Prefetching pays off once an event spans
+// several lines and the processor trails the publisher by a batch.
+TYPED_TEST(PrefetchTest, PublishWithPrefetchDistance)
+{
+    typedef RingBuffer<TypeParam, SingleThreadedStrategy, YieldingStrategy>
+        RingBufferType;
+    typedef BatchEventProcessor<TypeParam, RingBufferType> ProcessorType;
+    const int distances[] = { 0, 1, 2, 4, 8 };
+
+    for (size_t d = 0; d < sizeof(distances) / sizeof(distances[0]); ++d) {
+        RingBufferType ring_buffer(BUFFER_SIZE);
+        ReadingHandler<TypeParam> handler;
+        ProcessorType processor(&ring_buffer,
+                ring_buffer.newBarrier(std::vector<Sequence*>(0)),
+                &handler, NULL, stdext::chrono::milliseconds(1),
+                0, 0, distances[d]);
+        ring_buffer.setGatingSequences(
+                std::vector<Sequence*>(1, processor.getSequence()));
+        boost::thread consumer(boost::ref<ProcessorType>(processor));
+
+        double start = now();
+        for (long i = 0; i < ITERATIONS; ++i) {
+            int64_t sequence = ring_buffer.next();
+            ring_buffer.get(sequence)->write(i);
+            ring_buffer.publish(sequence);
+        }
+        while (processor.getSequence()->get() < ITERATIONS - 1) {
+            boost::this_thread::yield();
+        }
+        double duration = now() - start;
+
+        processor.halt();
+        consumer.join();
+        int64_t lines = (sizeof(TypeParam) + CACHE_LINE_SIZE_IN_BYTES - 1) /
+            CACHE_LINE_SIZE_IN_BYTES;
+        EXPECT_EQ(lines * ITERATIONS * (ITERATIONS - 1) / 2, handler.sum());
+
+        std::cout.precision(15);
+        std::cout << sizeof(TypeParam) << " bytes, prefetch distance "
+            << distances[d] << ": ";
+        std::cout << ITERATIONS / duration << " ops/secs, ";
+        std::cout << duration * ONE_SEC_IN_NANO / ITERATIONS << " ns per op"
+            << std::endl;
+    }
+}
+
+}
+}
@@ -0,0 +1,108 @@
+#include <time.h>
+
+#include <iostream>
+#include <vector>
+
+#include <boost/scoped_ptr.hpp>
+
+#include <disruptor/ring_buffer.h>
+
+#include <gtest/gtest.h>
+
+namespace disruptor {
+namespace test {
+
+static const uint64_t ONE_SEC_IN_NANO = 1000UL * 1000UL * 1000UL;
+static const int BUFFER_SIZE = 1024 * 8;
+
+struct ValueEvent
+{
+    int64_t value;
+};
+
+typedef RingBuffer<ValueEvent, SingleThreadedStrategy, BusySpinStrategy>
+    RuntimeCapacityRingBuffer;
+typedef FixedRingBuffer<ValueEvent, BUFFER_SIZE,
+                        SingleThreadedStrategy, BusySpinStrategy>
+    CompileTimeCapacityRingBuffer;
+
+template <typename RingBufferType>
+RingBufferType* newRingBuffer();
+
+template <>
+RuntimeCapacityRingBuffer* newRingBuffer<RuntimeCapacityRingBuffer>()
+{
+    return new RuntimeCapacityRingBuffer(BUFFER_SIZE);
+}
+
+template <>
+CompileTimeCapacityRingBuffer* newRingBuffer<CompileTimeCapacityRingBuffer>()
+{
+    return new CompileTimeCapacityRingBuffer();
+}
+
+template <typename RingBufferType>
+class RingBufferCapacityTest : public ::testing::Test
+{
+};
+
+typedef ::testing::Types<
+        RuntimeCapacityRingBuffer,
+        CompileTimeCapacityRingBuffer
+    > RingBufferCapacityTypes;
+TYPED_TEST_CASE(RingBufferCapacityTest, RingBufferCapacityTypes);
+
+// Publishes a batch then drains it on the same thread, so the measured cost
+// is claim, get and publish on one side and waitFor and get on the other,
+// without cross core traffic hiding the index arithmetic.
+TYPED_TEST(RingBufferCapacityTest, PublishAndConsumeOnOneThread)
+{
+    const long iterations = 1000L * 1000L * 100;
+    const int batch_size = 64;
+
+    boost::scoped_ptr<TypeParam> ring_buffer(newRingBuffer<TypeParam>());
+    Sequence consumed(INITIAL_CURSOR_VALUE);
+    ring_buffer->setGatingSequences(std::vector<Sequence*>(1, &consumed));
+    SequenceBarrierPtr barrier =
+        ring_buffer->newBarrier(std::vector<Sequence*>(0));
+
+    struct timespec start_time, end_time;
+    // +----- start timer -----+
+    clock_gettime(CLOCK_MONOTONIC, &start_time);
+
+    int64_t sum = 0;
+    int64_t next_sequence = 0;
+    for (long i = 0; i < iterations; i += batch_size) {
+        for (int j = 0; j < batch_size; ++j) {
+            int64_t sequence = ring_buffer->next();
+            ring_buffer->get(sequence)->value = i + j;
+            ring_buffer->publish(sequence);
+        }
+
+        int64_t available_sequence = barrier->waitFor(next_sequence);
+        for (; next_sequence <= available_sequence; ++next_sequence) {
+            sum += ring_buffer->get(next_sequence)->value;
+        }
+        consumed.set(available_sequence);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &end_time);
+    // +----- stop timer -----+
+
+    EXPECT_EQ(iterations - 1, consumed.get());
+    EXPECT_EQ(iterations * (iterations - 1) / 2, sum);
+
+    double start, end;
+    start = start_time.tv_sec + ((double) start_time.tv_nsec / (ONE_SEC_IN_NANO));
+    end = end_time.tv_sec + ((double) end_time.tv_nsec / (ONE_SEC_IN_NANO));
+    double duration = end - start;
+
+    std::cout.precision(15);
+    std::cout << "capacity " << BUFFER_SIZE << " performance: ";
+    std::cout << (iterations * 1.0) / duration << " ops/secs" << std::endl;
+    std::cout << "duration = " << duration << " secs" << std::endl;
+    std::cout << "ns per op = " << duration * ONE_SEC_IN_NANO / iterations << std::endl;
+}
+
+}
+}
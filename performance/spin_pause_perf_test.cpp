@@ -0,0 +1,162 @@
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#include <boost/atomic.hpp>
+#include <boost/thread.hpp>
+
+#include <disruptor/ring_buffer.h>
+
+#include <gtest/gtest.h>
+
+namespace disruptor {
+namespace test {
+
+static const uint64_t ONE_SEC_IN_NANO = 1000UL * 1000UL * 1000UL;
+static const int BUFFER_SIZE = 1024;
+static const long SIBLING_ITERATIONS = 1000L * 1000L * 200;
+
+struct ValueEvent
+{
+    int64_t value;
+};
+
+// Read the first two hyper threads of cpu0's core from sysfs, e.g. "0,4" or
+// "0-1".
+//
+// @return false if cpu0 has no SMT sibling.
+bool smtSiblings(int& first, int& second)
+{
+    std::ifstream siblings(
+            "/sys/devices/system/cpu/cpu0/topology/thread_siblings_list");
+    char separator = 0;
+    if (!(siblings >> first >> separator >> second)) {
+        return false;
+    }
+    return separator == ',' || separator == '-';
+}
+
+void pin(boost::thread& thread, int cpu)
+{
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    CPU_SET(cpu, &cpus);
+    pthread_setaffinity_np(thread.native_handle(), sizeof(cpus), &cpus);
+}
+
+double now()
+{
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return time.tv_sec + ((double) time.tv_nsec / (ONE_SEC_IN_NANO));
+}
+
+// Work of the thread sharing the core with the spinning processor.
+class SiblingWork
+{
+public:
+    SiblingWork() : result_(0), duration_(0) {}
+
+    void operator() ()
+    {
+        double start = now();
+        uint64_t x = 1;
+        for (long i = 0; i < SIBLING_ITERATIONS; ++i) {
+            x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+        }
+        duration_ = now() - start;
+        result_ = x;
+    }
+
+    uint64_t result() const { return result_; }
+
+    double duration() const { return duration_; }
+
+private:
+    uint64_t result_;
+    double duration_;
+};
+
+template <typename BarrierPtr>
+class Spinner
+{
+public:
+    explicit Spinner(BarrierPtr barrier) : barrier_(barrier) {}
+
+    void operator() () { barrier_->waitFor(0); }
+
+private:
+    BarrierPtr barrier_;
+};
+
+template <typename WaitStrategy>
+class SpinPauseTest : public ::testing::Test
+{
+};
+
+typedef ::testing::Types<
+        BusySpinStrategy,
+        PausingBusySpinStrategy
+    > SpinStrategyTypes;
+TYPED_TEST_CASE(SpinPauseTest, SpinStrategyTypes);
+
+// A processor spins on an empty ring on one hyper thread while the other
+// hyper thread of the same core runs a fixed amount of work, the slowdown of
+// that work is the cost of the spin loop to its sibling.
+TYPED_TEST(SpinPauseTest, SiblingSlowdownWhileSpinning)
+{
+    typedef RingBuffer<ValueEvent, SingleThreadedStrategy, TypeParam>
+        RingBufferType;
+    typedef stdext::shared_ptr<typename RingBufferType::barrier_type>
+        BarrierPtr;
+
+    int spinner_cpu = 0, sibling_cpu = 0;
+    bool smt = smtSiblings(spinner_cpu, sibling_cpu);
+    if (!smt) {
+        std::cout << "cpu0 has no SMT sibling, threads are not pinned"
+                  << std::endl;
+    }
+
+    SiblingWork alone;
+    boost::thread alone_thread(boost::ref(alone));
+    if (smt) {
+        pin(alone_thread, sibling_cpu);
+    }
+    alone_thread.join();
+
+    RingBufferType ring_buffer(BUFFER_SIZE);
+    Sequence consumed(INITIAL_CURSOR_VALUE);
+    ring_buffer.setGatingSequences(std::vector<Sequence*>(1, &consumed));
+    Spinner<BarrierPtr> spinner(
+            ring_buffer.newBarrier(std::vector<Sequence*>(0)));
+    boost::thread spinner_thread(boost::ref(spinner));
+    if (smt) {
+        pin(spinner_thread, spinner_cpu);
+    }
+
+    SiblingWork shared;
+    boost::thread shared_thread(boost::ref(shared));
+    if (smt) {
+        pin(shared_thread, sibling_cpu);
+    }
+    shared_thread.join();
+
+    ring_buffer.publish(ring_buffer.next());
+    spinner_thread.join();
+
+    EXPECT_EQ(alone.result(), shared.result());
+
+    std::cout.precision(15);
+    std::cout << "sibling alone = " << alone.duration() << " secs" << std::endl;
+    std::cout << "sibling next to spinner = " << shared.duration() << " secs"
+              << std::endl;
+    std::cout << "slowdown = " << shared.duration() / alone.duration()
+              << std::endl;
+}
+
+}
+}
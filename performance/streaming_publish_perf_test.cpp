@@ -0,0 +1,182 @@
+#include <string.h>
+#include <time.h>
+
+#include <iostream>
+#include <vector>
+
+#include <boost/ref.hpp>
+#include <boost/thread.hpp>
+
+#include <disruptor/event_processor.h>
+#include <disruptor/event_publisher.h>
+#include <disruptor/ring_buffer.h>
+
+#include <gtest/gtest.h>
+
+namespace disruptor {
+namespace test {
+
+static const uint64_t ONE_SEC_IN_NANO = 1000UL * 1000UL * 1000UL;
+static const int BUFFER_SIZE = 1024;
+static const int BATCH_SIZE = 8;
+// bytes published per run, split between the publishers
+static const int64_t BYTES_PER_RUN = 4L * 1024L * 1024L * 1024L;
+
+template <int N>
+struct PayloadEvent
+{
+    int64_t value;
+    char payload[N - sizeof(int64_t)];
+};
+
+template <typename Event>
+class FirstWordHandler : public IEventHandler<Event>
+{
+public:
+    FirstWordHandler() : sum_(0) {}
+
+    virtual void onEvent(const int64_t& sequence,
+                         const int64_t& batch_size,
+                         const bool& end_of_batch,
+                         Event* event)
+    {
+        if (event != NULL) {
+            sum_ += event->value;
+        }
+    }
+
+    virtual void onStart() {}
+
+    virtual void onShutdown() {}
+
+    int64_t sum() const { return sum_; }
+
+private:
+    int64_t sum_;
+};
+
+// Publisher copying batches of events it prepared in a local buffer, with
+// regular stores or through {@link EventPublisher#publishEventsStreaming()}.
+template <typename Event, typename RingBufferType>
+class CopyingPublisher
+{
+public:
+    CopyingPublisher(RingBufferType* ring_buffer, int64_t batches,
+                     bool streaming)
+        : ring_buffer_(ring_buffer)
+        , publisher_(ring_buffer)
+        , batches_(batches)
+        , streaming_(streaming)
+        , events_(BATCH_SIZE)
+    {
+        for (int i = 0; i < BATCH_SIZE; ++i) {
+            events_[i].value = 1;
+            memset(events_[i].payload, i, sizeof(events_[i].payload));
+        }
+    }
+
+    void operator() ()
+    {
+        for (int64_t i = 0; i < batches_; ++i) {
+            if (streaming_) {
+                publisher_.publishEventsStreaming(&events_[0], BATCH_SIZE);
+            }
+            else {
+                int64_t hi = ring_buffer_->next(BATCH_SIZE);
+                int64_t lo = hi - BATCH_SIZE + 1;
+                for (int j = 0; j < BATCH_SIZE; ++j) {
+                    memcpy(ring_buffer_->get(lo + j), &events_[j],
+                           sizeof(Event));
+                }
+                ring_buffer_->publish(lo, hi);
+            }
+        }
+    }
+
+private:
+    RingBufferType* ring_buffer_;
+    EventPublisher<Event, RingBufferType> publisher_;
+    const int64_t batches_;
+    const bool streaming_;
+    std::vector<Event> events_;
+};
+
+template <typename Event>
+class StreamingPublishTest : public ::testing::Test
+{
+};
+
+typedef ::testing::Types<
+        PayloadEvent<1024>,
+        PayloadEvent<4096>,
+        PayloadEvent<16384>
+    > StreamingEventTypes;
+TYPED_TEST_CASE(StreamingPublishTest, StreamingEventTypes);
+
+double now()
+{
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return time.tv_sec + ((double) time.tv_nsec / (ONE_SEC_IN_NANO));
+}
+
+// Publishers copy events into the ring with regular or non-temporal
+// stores, a processor reads their first word only, as a processor
+// forwarding the payload elsewhere would.
+TYPED_TEST(StreamingPublishTest, CopyIntoRing)
+{
+    typedef RingBuffer<TypeParam, MultiThreadedStrategy, YieldingStrategy>
+        RingBufferType;
+    typedef BatchEventProcessor<TypeParam, RingBufferType> ProcessorType;
+    typedef CopyingPublisher<TypeParam, RingBufferType> PublisherType;
+    const int producer_counts[] = { 1, 2, 4 };
+
+    for (size_t p = 0;
+            p < sizeof(producer_counts) / sizeof(producer_counts[0]); ++p) {
+        for (int streaming = 0; streaming < 2; ++streaming) {
+            const int num_producers = producer_counts[p];
+            const int64_t batches = BYTES_PER_RUN / sizeof(TypeParam) /
+                BATCH_SIZE / num_producers;
+            const int64_t iterations = batches * BATCH_SIZE * num_producers;
+
+            RingBufferType ring_buffer(BUFFER_SIZE);
+            FirstWordHandler<TypeParam> handler;
+            ProcessorType processor(&ring_buffer,
+                    ring_buffer.newBarrier(std::vector<Sequence*>(0)),
+                    &handler, NULL, stdext::chrono::milliseconds(1));
+            ring_buffer.setGatingSequences(
+                    std::vector<Sequence*>(1, processor.getSequence()));
+            boost::thread consumer(boost::ref<ProcessorType>(processor));
+
+            std::vector<PublisherType> publishers(num_producers,
+                    PublisherType(&ring_buffer, batches, streaming != 0));
+            boost::thread_group producers;
+
+            double start = now();
+            for (int i = 0; i < num_producers; ++i) {
+                producers.create_thread(
+                        boost::ref<PublisherType>(publishers[i]));
+            }
+            producers.join_all();
+            while (processor.getSequence()->get() < iterations - 1) {
+                boost::this_thread::yield();
+            }
+            double duration = now() - start;
+
+            processor.halt();
+            consumer.join();
+            EXPECT_EQ(iterations, handler.sum());
+
+            std::cout.precision(15);
+            std::cout << sizeof(TypeParam) << " bytes, " << num_producers
+                << (streaming ? " streaming" : " regular")
+                << " publishers: ";
+            std::cout << iterations / duration << " ops/secs, ";
+            std::cout << BYTES_PER_RUN / duration / (1024 * 1024)
+                << " MB/secs" << std::endl;
+        }
+    }
+}
+
+}
+}
@@ -0,0 +1,131 @@
+#include <vector>
+
+#include <disruptor/clock.h>
+#include <disruptor/ring_buffer.h>
+
+#include <gtest/gtest.h>
+
+#include "utils.h"
+
+namespace disruptor {
+namespace test {
+
+// Clock under control of the test, counting its reads.
+class ManualClock
+{
+public:
+    static int64_t nanoTime()
+    {
+        ++reads;
+        return now;
+    }
+
+    static int64_t now;
+    static int reads;
+};
+
+int64_t ManualClock::now = 0;
+int ManualClock::reads = 0;
+
+TEST(DeadlineTest, testClockIsOnlyReadEveryCheckInterval)
+{
+    ManualClock::now = 0;
+    ManualClock::reads = 0;
+    BasicDeadline<ManualClock> deadline(stdext::chrono::microseconds(1), 4);
+
+    // the deadline is set on construction.
+    EXPECT_EQ(1, ManualClock::reads);
+
+    ManualClock::now = 999;
+    for (int i = 0; i < 4; i++) {
+        EXPECT_FALSE(deadline.expired());
+    }
+    EXPECT_EQ(2, ManualClock::reads);
+
+    ManualClock::now = 1000;
+    for (int i = 0; i < 3; i++) {
+        EXPECT_FALSE(deadline.expired());
+    }
+    EXPECT_TRUE(deadline.expired());
+    EXPECT_EQ(3, ManualClock::reads);
+}
+
+TEST(DeadlineTest, testRemainingNanos)
+{
+    ManualClock::now = 0;
+    BasicDeadline<ManualClock> deadline(stdext::chrono::microseconds(1));
+
+    ManualClock::now = 400;
+    EXPECT_EQ(600, deadline.remainingNanos());
+    ManualClock::now = 2000;
+    EXPECT_EQ(0, deadline.remainingNanos());
+}
+
+TEST(DeadlineTest, testWaitClocksAreMonotonic)
+{
+    int64_t previous = WaitClock::nanoTime();
+    for (int i = 0; i < 1000; i++) {
+        int64_t now = WaitClock::nanoTime();
+        EXPECT_LE(previous, now);
+        previous = now;
+    }
+}
+
+#if defined(__i386__) || defined(__x86_64__)
+TEST(DeadlineTest, testTscClockFollowsMonotonicClock)
+{
+    TscClock::calibrate();
+    int64_t tsc_start = TscClock::nanoTime();
+    int64_t start = MonotonicClock::nanoTime();
+    stdext::this_thread::sleep_for(stdext::chrono::milliseconds(20));
+    int64_t tsc_elapsed = TscClock::nanoTime() - tsc_start;
+    int64_t elapsed = MonotonicClock::nanoTime() - start;
+
+    EXPECT_NEAR(elapsed, tsc_elapsed, elapsed / 10);
+}
+#endif
+
+template <typename WaitStrategy>
+class TimedWaitTest : public ::testing::Test
+{
+};
+
+typedef ::testing::Types<
+        SleepingStrategy,
+        YieldingStrategy,
+        BusySpinStrategy,
+        PausingBusySpinStrategy
+    > TimedWaitStrategyTypes;
+TYPED_TEST_CASE(TimedWaitTest, TimedWaitStrategyTypes);
+
+TYPED_TEST(TimedWaitTest, testWaitForTimesOut)
+{
+    RingBuffer<StubEvent, SingleThreadedStrategy, TypeParam> ring_buffer(16);
+    int64_t start = MonotonicClock::nanoTime();
+
+    int64_t sequence = ring_buffer.newBarrier(std::vector<Sequence*>())
+        ->waitFor(0, stdext::chrono::milliseconds(5));
+
+    int64_t elapsed = MonotonicClock::nanoTime() - start;
+    EXPECT_EQ(INITIAL_CURSOR_VALUE, sequence);
+    EXPECT_GE(elapsed, 5L * 1000L * 1000L);
+    EXPECT_LT(elapsed, 1000L * 1000L * 1000L);
+}
+
+TEST(PhasedBackoffTimedWaitTest, testWaitForTimesOut)
+{
+    RingBuffer<StubEvent> ring_buffer(16, kSingleThreadedStrategy,
+            kPhasedBackoffSleepingStrategy, TimeConfig());
+    int64_t start = MonotonicClock::nanoTime();
+
+    int64_t sequence = ring_buffer.newBarrier(std::vector<Sequence*>())
+        ->waitFor(0, stdext::chrono::milliseconds(5));
+
+    int64_t elapsed = MonotonicClock::nanoTime() - start;
+    EXPECT_EQ(INITIAL_CURSOR_VALUE, sequence);
+    EXPECT_GE(elapsed, 5L * 1000L * 1000L);
+    EXPECT_LT(elapsed, 1000L * 1000L * 1000L);
+}
+
+};  // namespace test
+};  // namespace disruptor
@@ -0,0 +1,199 @@
+#include <vector>
+
+#include <boost/atomic.hpp>
+#include <boost/thread.hpp>
+
+#include <disruptor/disruptor.h>
+
+#include <gtest/gtest.h>
+
+#include "utils.h"
+
+#define BUFFER_SIZE 64
+
+namespace disruptor {
+namespace test {
+
+class StageHandler : public IEventHandler<StubEvent>
+{
+public:
+    StageHandler()
+        : processed_(INITIAL_CURSOR_VALUE)
+        , blocked_(false)
+        , out_of_order_(0)
+    {
+    }
+
+    void follow(Sequence* upstream) { upstream_.push_back(upstream); }
+
+    void block(bool blocked) { blocked_.store(blocked); }
+
+    virtual void onEvent(const int64_t& sequence,
+                         const int64_t& batch_size,
+                         const bool& end_of_batch,
+                         StubEvent* event)
+    {
+        if (event == NULL) {
+            return;
+        }
+
+        while (blocked_.load()) {
+            boost::this_thread::yield();
+        }
+
+        if (!upstream_.empty() && getMinimumSequence(upstream_) < sequence) {
+            out_of_order_++;
+        }
+        processed_.store(sequence);
+    }
+
+    virtual void onStart() {}
+
+    virtual void onShutdown() {}
+
+    int64_t processed() const { return processed_.load(); }
+
+    int out_of_order() const { return out_of_order_; }
+
+private:
+    DependentSequences     upstream_;
+    boost::atomic<int64_t> processed_;
+    boost::atomic<bool>    blocked_;
+    int                    out_of_order_;
+};
+
+class StubEventTranslator : public IEventTranslator<StubEvent>
+{
+public:
+    virtual StubEvent* translateTo(const int64_t& sequence, StubEvent* event)
+    {
+        event->set_value(static_cast<int>(sequence));
+        return event;
+    }
+};
+
+void publish(Disruptor<StubEvent>* disruptor, int n)
+{
+    StubEventTranslator translator;
+    for (int i = 0; i < n; i++) {
+        disruptor->publishEvent(&translator);
+    }
+}
+
+void waitUntilProcessed(const StageHandler& handler, int64_t sequence)
+{
+    while (handler.processed() < sequence) {
+        boost::this_thread::yield();
+    }
+}
+
+TEST(DisruptorGraphTest, testDiamondRunsJoinAfterBothBranches)
+{
+    Disruptor<StubEvent> disruptor(BUFFER_SIZE,
+                                   kSingleThreadedStrategy,
+                                   kYieldingStrategy);
+    StageHandler a, b, c, d;
+
+    EventHandlerGroup<StubEvent> head = disruptor.handleEventsWith(&a);
+    head.then(&b);
+    head.then(&c);
+    disruptor.after(&b, &c).then(&d);
+
+    b.follow(disruptor.getSequenceFor(&a));
+    c.follow(disruptor.getSequenceFor(&a));
+    d.follow(disruptor.getSequenceFor(&b));
+    d.follow(disruptor.getSequenceFor(&c));
+    disruptor.start();
+
+    const int n = BUFFER_SIZE * 4;
+    publish(&disruptor, n);
+    waitUntilProcessed(d, n - 1);
+    disruptor.stop();
+
+    EXPECT_EQ(n - 1, a.processed());
+    EXPECT_EQ(n - 1, b.processed());
+    EXPECT_EQ(n - 1, c.processed());
+    EXPECT_EQ(0, b.out_of_order());
+    EXPECT_EQ(0, c.out_of_order());
+    EXPECT_EQ(0, d.out_of_order());
+}
+
+TEST(DisruptorGraphTest, testChainAfterSingleHandler)
+{
+    Disruptor<StubEvent> disruptor(BUFFER_SIZE,
+                                   kSingleThreadedStrategy,
+                                   kYieldingStrategy);
+    StageHandler a, b, c;
+
+    disruptor.handleEventsWith(&a, &b);
+    EventHandlerGroup<StubEvent> group = disruptor.after(&a);
+    EXPECT_EQ(1U, group.getSequences().size());
+    group.then(&c);
+
+    c.follow(disruptor.getSequenceFor(&a));
+    disruptor.start();
+
+    const int n = BUFFER_SIZE * 4;
+    publish(&disruptor, n);
+    waitUntilProcessed(b, n - 1);
+    waitUntilProcessed(c, n - 1);
+    disruptor.stop();
+
+    EXPECT_EQ(0, c.out_of_order());
+}
+
+TEST(DisruptorGraphTest, testProcessorWithoutHandlersThrows)
+{
+    Disruptor<StubEvent> disruptor(BUFFER_SIZE,
+                                   kSingleThreadedStrategy,
+                                   kYieldingStrategy);
+    EXPECT_THROW(disruptor.processor(), std::runtime_error);
+}
+
+TEST(DisruptorGraphTest, testStartWithoutHandlersThrows)
+{
+    Disruptor<StubEvent> disruptor(BUFFER_SIZE,
+                                   kSingleThreadedStrategy,
+                                   kYieldingStrategy);
+    EXPECT_THROW(disruptor.start(), std::runtime_error);
+}
+
+TEST(DisruptorGraphTest, testPublishersAreGatedOnEndOfChain)
+{
+    Disruptor<StubEvent> disruptor(BUFFER_SIZE,
+                                   kSingleThreadedStrategy,
+                                   kYieldingStrategy);
+    StageHandler a, b, c;
+    c.block(true);
+
+    disruptor.handleEventsWith(&a, &b).then(&c);
+    disruptor.start();
+
+    publish(&disruptor, BUFFER_SIZE);
+    waitUntilProcessed(a, BUFFER_SIZE - 1);
+    waitUntilProcessed(b, BUFFER_SIZE - 1);
+
+    // a and b are done, only the blocked c keeps the buffer full
+    EXPECT_TRUE(disruptor.full());
+
+    c.block(false);
+    waitUntilProcessed(c, BUFFER_SIZE - 1);
+    EXPECT_FALSE(disruptor.full());
+    disruptor.stop();
+}
+
+TEST(DisruptorGraphTest, testRejectHandlersAfterStart)
+{
+    Disruptor<StubEvent> disruptor(BUFFER_SIZE,
+                                   kSingleThreadedStrategy,
+                                   kYieldingStrategy);
+    StageHandler a, b;
+    disruptor.handleEventsWith(&a);
+    disruptor.start();
+
+    EXPECT_THROW(disruptor.handleEventsWith(&b), std::runtime_error);
+    disruptor.stop();
+}
+
+};  // namespace test
+};  // namespace disruptor
@@ -0,0 +1,120 @@
+#include <vector>
+
+#include <disruptor/event_poller.h>
+#include <disruptor/ring_buffer.h>
+
+#include <gtest/gtest.h>
+
+#include "utils.h"
+
+#define BUFFER_SIZE 16
+
+namespace disruptor {
+namespace test {
+
+class CollectingPollHandler : public IPollHandler<StubEvent>
+{
+public:
+    explicit CollectingPollHandler(int stop_after = -1)
+        : stop_after_(stop_after)
+    {
+    }
+
+    virtual bool onEvent(const int64_t& sequence,
+                         const bool& end_of_batch,
+                         StubEvent* event)
+    {
+        values_.push_back(event->value());
+        return static_cast<int>(values_.size()) != stop_after_;
+    }
+
+    const std::vector<int>& values() const { return values_; }
+
+private:
+    int stop_after_;
+    std::vector<int> values_;
+};
+
+class EventPollerFixture : public ::testing::Test
+{
+protected:
+    EventPollerFixture()
+        : ring_buffer(&factory,
+                      BUFFER_SIZE,
+                      kSingleThreadedStrategy,
+                      kSleepingStrategy)
+        , gating_sequence(INITIAL_CURSOR_VALUE)
+    {
+    }
+
+    void publish(int n)
+    {
+        for (int i = 0; i < n; i++) {
+            int64_t sequence = ring_buffer.next();
+            ring_buffer.get(sequence)->set_value(static_cast<int>(sequence));
+            ring_buffer.publish(sequence);
+        }
+    }
+
+    StubEventFactory factory;
+    RingBuffer<StubEvent> ring_buffer;
+    Sequence gating_sequence;
+};
+
+TEST_F(EventPollerFixture, testPollReportsIdleThenProcessing)
+{
+    EventPoller<StubEvent> poller(&ring_buffer,
+            ring_buffer.newBarrier(DependentSequences()));
+    ring_buffer.setGatingSequences(
+            DependentSequences(1, poller.getSequence()));
+    CollectingPollHandler handler;
+
+    EXPECT_EQ(kIdle, poller.poll(&handler));
+
+    publish(3);
+    EXPECT_EQ(kProcessing, poller.poll(&handler));
+    ASSERT_EQ(3u, handler.values().size());
+    EXPECT_EQ(2, handler.values()[2]);
+    EXPECT_EQ(2L, poller.getSequence()->get());
+
+    EXPECT_EQ(kIdle, poller.poll(&handler));
+}
+
+TEST_F(EventPollerFixture, testPollReportsGatingOnDependentSequence)
+{
+    EventPoller<StubEvent> poller(&ring_buffer,
+            ring_buffer.newBarrier(DependentSequences(1, &gating_sequence)));
+    ring_buffer.setGatingSequences(
+            DependentSequences(1, poller.getSequence()));
+    CollectingPollHandler handler;
+
+    publish(2);
+    EXPECT_EQ(kGating, poller.poll(&handler));
+
+    gating_sequence.set(0L);
+    EXPECT_EQ(kProcessing, poller.poll(&handler));
+    EXPECT_EQ(1u, handler.values().size());
+    EXPECT_EQ(0L, poller.getSequence()->get());
+}
+
+TEST_F(EventPollerFixture, testPollHonoursBatchLimitAndHandlerStop)
+{
+    EventPoller<StubEvent> poller(&ring_buffer,
+            ring_buffer.newBarrier(DependentSequences()), 4);
+    ring_buffer.setGatingSequences(
+            DependentSequences(1, poller.getSequence()));
+
+    publish(10);
+    CollectingPollHandler limited;
+    EXPECT_EQ(kProcessing, poller.poll(&limited));
+    EXPECT_EQ(4u, limited.values().size());
+    EXPECT_EQ(3L, poller.getSequence()->get());
+
+    CollectingPollHandler stopping(2);
+    EXPECT_EQ(kProcessing, poller.poll(&stopping));
+    EXPECT_EQ(2u, stopping.values().size());
+    EXPECT_EQ(5L, poller.getSequence()->get());
+}
+
+};  // namespace test
+};  // namespace disruptor
@@ -0,0 +1,249 @@
+#include <boost/atomic.hpp>
+#include <boost/thread.hpp>
+
+#include <disruptor/event_processor.h>
+#include <disruptor/ring_buffer.h>
+
+#include <gtest/gtest.h>
+
+#include "utils.h"
+
+#define BUFFER_SIZE 64
+
+namespace disruptor {
+namespace test {
+
+// Handler blocking on a chosen sequence until released by the test, so the
+// test can look at the sequence of the processor in the middle of a batch.
+class BlockingHandler : public ISequenceReportingEventHandler<StubEvent>
+{
+public:
+    BlockingHandler(int64_t block_sequence, int64_t report_sequence)
+        : block_sequence_(block_sequence)
+        , report_sequence_(report_sequence)
+        , sequence_callback_(NULL)
+        , blocked_(false)
+        , released_(false)
+        , count_(0)
+    {
+    }
+
+    virtual void setSequenceCallback(ISequenceCallback* sequence_callback)
+    {
+        sequence_callback_ = sequence_callback;
+    }
+
+    virtual void onEvent(const int64_t& sequence,
+                         const int64_t& batch_size,
+                         const bool& end_of_batch,
+                         StubEvent* event)
+    {
+        if (event == NULL) {
+            return;
+        }
+        count_.fetch_add(1);
+        if (sequence == report_sequence_) {
+            sequence_callback_->set(sequence);
+        }
+        if (sequence == block_sequence_) {
+            blocked_.store(true);
+            while (!released_.load()) {
+                boost::this_thread::yield();
+            }
+        }
+    }
+
+    virtual void onStart() {}
+
+    virtual void onShutdown() {}
+
+    void waitUntilBlocked() const
+    {
+        while (!blocked_.load()) {
+            boost::this_thread::yield();
+        }
+    }
+
+    void release() { released_.store(true); }
+
+    int count() const { return count_.load(); }
+
+private:
+    const int64_t block_sequence_;
+    const int64_t report_sequence_;
+    ISequenceCallback* sequence_callback_;
+    boost::atomic<bool> blocked_;
+    boost::atomic<bool> released_;
+    boost::atomic<int> count_;
+};
+
+// Handler recording the batches it is handed.
+class BatchTrackingHandler : public IEventHandler<StubEvent>
+{
+public:
+    BatchTrackingHandler() : max_batch_size_(0), end_of_batches_(0) {}
+
+    virtual void onEvent(const int64_t& sequence,
+                         const int64_t& batch_size,
+                         const bool& end_of_batch,
+                         StubEvent* event)
+    {
+        if (event == NULL) {
+            return;
+        }
+        if (batch_size > max_batch_size_) {
+            max_batch_size_ = batch_size;
+        }
+        if (end_of_batch) {
+            end_of_batches_++;
+        }
+    }
+
+    virtual void onStart() {}
+
+    virtual void onShutdown() {}
+
+    int64_t max_batch_size() const { return max_batch_size_; }
+
+    int end_of_batches() const { return end_of_batches_; }
+
+private:
+    int64_t max_batch_size_;
+    int end_of_batches_;
+};
+
+class EventProcessorFixture : public ::testing::Test
+{
+public:
+    typedef BatchEventProcessor<StubEvent> processor_type;
+
+    EventProcessorFixture()
+        : ring_buffer_(&factory_, BUFFER_SIZE,
+                       kSingleThreadedStrategy, kYieldingStrategy)
+        , barrier_(ring_buffer_.newBarrier(DependentSequences()))
+    {
+    }
+
+    void publish(int count)
+    {
+        for (int i = 0; i < count; i++) {
+            ring_buffer_.publish(ring_buffer_.next());
+        }
+    }
+
+    // Publish a batch, run the processor until the handler blocks and
+    // return the sequence of the processor at that point.
+    int64_t sequenceWhenBlocked(BlockingHandler& handler,
+                                int progress_interval)
+    {
+        processor_type processor(&ring_buffer_, barrier_, &handler, NULL,
+                stdext::chrono::milliseconds(1), progress_interval);
+        ring_buffer_.setGatingSequences(
+                DependentSequences(1, processor.getSequence()));
+        publish(32);
+
+        boost::thread thread(boost::ref<processor_type>(processor));
+        handler.waitUntilBlocked();
+        int64_t sequence = processor.getSequence()->get();
+        handler.release();
+
+        while (processor.getSequence()->get() < 31) {
+            boost::this_thread::yield();
+        }
+        processor.halt();
+        thread.join();
+        EXPECT_EQ(32, handler.count());
+        return sequence;
+    }
+
+    StubEventFactory factory_;
+    RingBuffer<StubEvent> ring_buffer_;
+    stdext::shared_ptr<processor_type::barrier_type> barrier_;
+};
+
+TEST_F(EventProcessorFixture, testSequenceIsOnlySetAtEndOfBatch)
+{
+    BlockingHandler handler(20, -1);
+    EXPECT_EQ(INITIAL_CURSOR_VALUE, sequenceWhenBlocked(handler, 0));
+}
+
+TEST_F(EventProcessorFixture, testSequenceIsSetEveryProgressInterval)
+{
+    BlockingHandler handler(20, -1);
+    EXPECT_EQ(15L, sequenceWhenBlocked(handler, 8));
+}
+
+TEST_F(EventProcessorFixture, testHandlerReportsSequence)
+{
+    BlockingHandler handler(20, 17);
+    EXPECT_EQ(17L, sequenceWhenBlocked(handler, 0));
+}
+
+TEST_F(EventProcessorFixture, testNegativeProgressIntervalThrows)
+{
+    BlockingHandler handler(-1, -1);
+    EXPECT_THROW(processor_type(&ring_buffer_, barrier_, &handler, NULL,
+                stdext::chrono::milliseconds(1), -1),
+            std::invalid_argument);
+}
+
+TEST_F(EventProcessorFixture, testBatchesAreCappedToMaxBatchSize)
+{
+    BatchTrackingHandler handler;
+    processor_type processor(&ring_buffer_, barrier_, &handler, NULL,
+            stdext::chrono::milliseconds(1), 0, 8);
+    ring_buffer_.setGatingSequences(
+            DependentSequences(1, processor.getSequence()));
+    publish(32);
+
+    boost::thread thread(boost::ref<processor_type>(processor));
+    while (processor.getSequence()->get() < 31) {
+        boost::this_thread::yield();
+    }
+    processor.halt();
+    thread.join();
+
+    EXPECT_EQ(8, handler.max_batch_size());
+    EXPECT_EQ(4, handler.end_of_batches());
+}
+
+TEST_F(EventProcessorFixture, testNegativeMaxBatchSizeThrows)
+{
+    BatchTrackingHandler handler;
+    EXPECT_THROW(processor_type(&ring_buffer_, barrier_, &handler, NULL,
+                stdext::chrono::milliseconds(1), 0, -1),
+            std::invalid_argument);
+}
+
+TEST_F(EventProcessorFixture, testPrefetchingProcessorHandlesEveryEvent)
+{
+    BlockingHandler handler(-1, -1);
+    processor_type processor(&ring_buffer_, barrier_, &handler, NULL,
+            stdext::chrono::milliseconds(1), 0, 0, 16);
+    ring_buffer_.setGatingSequences(
+            DependentSequences(1, processor.getSequence()));
+
+    boost::thread thread(boost::ref<processor_type>(processor));
+    // wraps the buffer, with batches both shorter and longer than the
+    // prefetch distance
+    publish(3);
+    publish(4 * BUFFER_SIZE);
+    while (processor.getSequence()->get() < 4 * BUFFER_SIZE + 2) {
+        boost::this_thread::yield();
+    }
+    processor.halt();
+    thread.join();
+
+    EXPECT_EQ(4 * BUFFER_SIZE + 3, handler.count());
+}
+
+TEST_F(EventProcessorFixture, testNegativePrefetchDistanceThrows)
+{
+    BatchTrackingHandler handler;
+    EXPECT_THROW(processor_type(&ring_buffer_, barrier_, &handler, NULL,
+                stdext::chrono::milliseconds(1), 0, 0, -1),
+            std::invalid_argument);
+}
+
+};  // namespace test
+};  // namespace disruptor
@@ -88,6 +88,59 @@ class Producer
         }
 };
 
+// Producer publishing each burst with a single claim and publish through
+// {@link Disruptor#publishEvents()}, translators stamped in place in an
+// array allocated once. Bursts are never throttled.
+class BatchProducer
+{
+    private:
+        long iterations_;
+        Disruptor<test::TimestampEvent>& disruptor_;
+        const int batch_;
+        std::vector<test::TimestampEventTranslator> translators_;
+        std::vector<IEventTranslator<test::TimestampEvent>*> translator_ptrs_;
+
+    public:
+        explicit BatchProducer(long i
+                , Disruptor<test::TimestampEvent>& disruptor
+                , int throttle)
+            : iterations_(i)
+            , disruptor_(disruptor)
+            , batch_(DEFAULT_SENDING_BATCH_SIZE)
+            , translators_(batch_)
+        {
+        }
+
+        void operator() ()
+        {
+            using namespace disruptor;
+            using namespace boost::chrono;
+            assert(batch_ > 0);
+            int num_batches = iterations_ / batch_;
+            const Nanoseconds interval_between_batch(
+                    Nanoseconds(ONE_SEC_IN_NANO / num_batches - COST_OF_A_TIME_FUNCTION_CALL_NS));
+
+            // point at the translators of this copy, the thread runs one
+            translator_ptrs_.resize(batch_);
+            for (int i=0; i<batch_; ++i) {
+                translator_ptrs_[i] = &translators_[i];
+            }
+
+            disruptor::MonoTime start;
+            for (int j=0; j<num_batches; ++j) {
+                start = MonoTime::clock::now();
+                for (int i=0; i<batch_; ++i) {
+                    translators_[i] = test::TimestampEventTranslator(start);
+                }
+
+                disruptor_.publishEvents(&translator_ptrs_[0], batch_);
+
+                while (duration_cast<Nanoseconds>(MonoTime::clock::now() - start) < interval_between_batch) {
+                }
+            }
+        }
+};
+
 class DynamicProducer
 {
     private:
@@ -248,6 +301,22 @@ class MultiLowContentionYielding : public Disruptor<test::TimestampEvent>
         typedef Producer producer_type;
 };
 
+template<int NumProducer>
+class MultiAvailabilityYielding : public Disruptor<test::TimestampEvent>
+{
+    public:
+        MultiAvailabilityYielding(int buffer_size, test::TimestampBatchHandler* handler) :
+            Disruptor<test::TimestampEvent>(buffer_size, kMultiThreadedAvailabilityStrategy, kYieldingStrategy, handler, NULL)
+        {
+        }
+
+        int supportedProducerNum() const
+        {
+            return NumProducer;
+        }
+        typedef Producer producer_type;
+};
+
 template<int NumProducer>
 class SingleBusySpin : public Disruptor<test::TimestampEvent>
 {
@@ -296,6 +365,22 @@ class MultiLowContentionBusySpin : public Disruptor<test::TimestampEvent>
         typedef Producer producer_type;
 };
 
+template<int NumProducer>
+class MultiAvailabilityBusySpin : public Disruptor<test::TimestampEvent>
+{
+    public:
+        MultiAvailabilityBusySpin(int buffer_size, test::TimestampBatchHandler* handler) :
+            Disruptor<test::TimestampEvent>(buffer_size, kMultiThreadedAvailabilityStrategy, kBusySpinStrategy, handler, NULL)
+        {
+        }
+
+        int supportedProducerNum() const
+        {
+            return NumProducer;
+        }
+        typedef Producer producer_type;
+};
+
 template<int NumProducer, WaitStrategyOption WaitStrategy>
 class DynamicSingleWith : public DynamicDisruptor<test::TimestampEvent>
 {
@@ -318,6 +403,20 @@ class DynamicSingleWith : public DynamicDisruptor<test::TimestampEvent>
 };
 
 
+// Disruptor of DisruptorType published to in batches.
+template<typename DisruptorType>
+class BatchPublishing : public DisruptorType
+{
+    public:
+        BatchPublishing(int buffer_size, test::TimestampBatchHandler* handler) :
+            DisruptorType(buffer_size, handler)
+        {
+        }
+
+        typedef BatchProducer producer_type;
+};
+
+
 template <typename DisruptorType>
 class DisruptorPerfFixture : public ::testing::Test
 {
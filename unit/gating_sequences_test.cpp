@@ -0,0 +1,165 @@
+#include <vector>
+
+#include <disruptor/gating_sequences.h>
+#include <disruptor/ring_buffer.h>
+
+#include <gtest/gtest.h>
+
+#include "utils.h"
+
+namespace disruptor {
+namespace test {
+
+class GatingSequencesFixture : public ::testing::Test
+{
+public:
+    GatingSequencesFixture() : sequences_(20)
+    {
+        for (size_t i = 0; i < sequences_.size(); ++i) {
+            sequences_[i].set(100 + i);
+            dependents_.push_back(&sequences_[i]);
+        }
+    }
+
+    std::vector<Sequence> sequences_;
+    DependentSequences dependents_;
+};
+
+TEST_F(GatingSequencesFixture, testEmptyHasNoMinimum)
+{
+    GatingSequences gating;
+    EXPECT_TRUE(gating.empty());
+    EXPECT_EQ(LONG_MAX, gating.getMinimumSequence());
+    EXPECT_EQ(LONG_MAX, gating.getMinimumSequence(0L));
+}
+
+TEST_F(GatingSequencesFixture, testGetMinimumSequence)
+{
+    GatingSequences gating(dependents_, 8);
+    EXPECT_EQ(20U, gating.sequences().size());
+    EXPECT_EQ(100L, gating.getMinimumSequence());
+
+    sequences_[0].set(200L);
+    sequences_[13].set(50L);
+    EXPECT_EQ(50L, gating.getMinimumSequence());
+    EXPECT_EQ(50L, gating.getMinimumSequence(100L));
+}
+
+TEST_F(GatingSequencesFixture, testCachedMinimumIsALowerBound)
+{
+    GatingSequences gating(dependents_, 8);
+    EXPECT_EQ(100L, gating.getMinimumSequence(100L));
+
+    // the cached minimums already cover the required sequence, the moved
+    // sequences are not read
+    for (size_t i = 0; i < sequences_.size(); ++i) {
+        sequences_[i].set(1000L);
+    }
+    EXPECT_EQ(100L, gating.getMinimumSequence(100L));
+    EXPECT_EQ(1000L, gating.getMinimumSequence(500L));
+}
+
+TEST_F(GatingSequencesFixture, testStopsAtFirstLaggingGroup)
+{
+    GatingSequences gating(dependents_, 8);
+    EXPECT_EQ(100L, gating.getMinimumSequence(100L));
+
+    for (size_t i = 0; i < sequences_.size(); ++i) {
+        sequences_[i].set(i == 10 ? 300L : 400L);
+    }
+    // the second group is still behind, the required sequence is not
+    // reached whatever the other groups hold
+    EXPECT_EQ(300L, gating.getMinimumSequence(350L));
+
+    // the lagging group is checked first from now on
+    sequences_[10].set(400L);
+    EXPECT_EQ(400L, gating.getMinimumSequence(400L));
+}
+
+// Snapshot counting its destructions.
+class CountedSnapshot
+{
+public:
+    explicit CountedSnapshot(int* freed) : freed_(freed) {}
+
+    ~CountedSnapshot() { ++*freed_; }
+
+private:
+    int* freed_;
+};
+
+TEST(AtomicSnapshotTest, testReplacedSnapshotIsFreedOnReclaim)
+{
+    int freed = 0;
+    {
+        AtomicSnapshot<CountedSnapshot> snapshot(new CountedSnapshot(&freed));
+        const CountedSnapshot* first = snapshot.load();
+        snapshot.store(new CountedSnapshot(&freed));
+        snapshot.store(new CountedSnapshot(&freed));
+        EXPECT_NE(first, snapshot.load());
+        // still readable by a reader which loaded it
+        EXPECT_EQ(0, freed);
+
+        snapshot.reclaim();
+        EXPECT_EQ(2, freed);
+    }
+    EXPECT_EQ(3, freed);
+}
+
+TEST_F(GatingSequencesFixture, testReplacedSnapshotIsReadableUntilReclaimed)
+{
+    AtomicGatingSequences gating(dependents_);
+    const GatingSequences* replaced = gating.load();
+
+    gating.store(DependentSequences(1, &sequences_[5]));
+    EXPECT_EQ(105L, gating.getMinimumSequence());
+    EXPECT_EQ(100L, replaced->getMinimumSequence());
+    gating.reclaim();
+    EXPECT_EQ(105L, gating.getMinimumSequence());
+}
+
+TEST_F(GatingSequencesFixture, testSequencerWrapsOnCachedMinimums)
+{
+    RingBuffer<StubEvent, SingleThreadedStrategy, BusySpinStrategy>
+        ring_buffer(4);
+    std::vector<Sequence> consumers(10);
+    DependentSequences gating;
+    for (size_t i = 0; i < consumers.size(); ++i) {
+        gating.push_back(&consumers[i]);
+    }
+    ring_buffer.setGatingSequences(gating);
+
+    for (int64_t i = 0; i < 4; ++i) {
+        ring_buffer.publish(ring_buffer.next());
+    }
+    EXPECT_FALSE(ring_buffer.hasAvailableCapacity());
+
+    for (size_t i = 0; i < consumers.size() - 1; ++i) {
+        consumers[i].set(3L);
+    }
+    EXPECT_FALSE(ring_buffer.hasAvailableCapacity());
+
+    consumers.back().set(1L);
+    EXPECT_TRUE(ring_buffer.hasAvailableCapacity());
+    EXPECT_EQ(2, ring_buffer.remainingCapacity());
+}
+
+TEST_F(GatingSequencesFixture, testBarrierReadsDependentsThroughCache)
+{
+    RingBuffer<StubEvent, SingleThreadedStrategy, BusySpinStrategy>
+        ring_buffer(32);
+    for (int64_t i = 0; i < 20; ++i) {
+        ring_buffer.publish(ring_buffer.next());
+    }
+    for (size_t i = 0; i < sequences_.size(); ++i) {
+        sequences_[i].set(10L + (i % 5));
+    }
+
+    SequenceBarrierPtr barrier = ring_buffer.newBarrier(dependents_);
+    EXPECT_EQ(10L, barrier->waitFor(10L));
+    EXPECT_EQ(10L, barrier->waitFor(5L, stdext::chrono::milliseconds(1)));
+    EXPECT_EQ(10L, barrier->waitFor(11L, stdext::chrono::milliseconds(1)));
+}
+
+};  // namespace test
+};  // namespace disruptor
@@ -0,0 +1,291 @@
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/thread.hpp>
+
+#include <disruptor/multi_buffer_event_processor.h>
+#include <disruptor/ring_buffer.h>
+
+#include <gtest/gtest.h>
+
+#include "utils.h"
+
+#define BUFFER_SIZE 64
+#define NUM_BUFFERS 3
+#define MAX_BATCH_SIZE 8
+
+namespace disruptor {
+namespace test {
+
+class BufferTrackingHandler : public IEventHandler<StubEvent>
+{
+public:
+    BufferTrackingHandler()
+        : counts_(NUM_BUFFERS, 0)
+        , max_batch_size_(0)
+    {
+    }
+
+    virtual void onEvent(const int64_t& sequence,
+                         const int64_t& batch_size,
+                         const bool& end_of_batch,
+                         StubEvent* event)
+    {
+        counts_[event->value()]++;
+        if (batch_size > max_batch_size_) {
+            max_batch_size_ = batch_size;
+        }
+    }
+
+    virtual void onStart() {}
+
+    virtual void onShutdown() {}
+
+    int count(int buffer) const { return counts_[buffer]; }
+
+    int64_t max_batch_size() const { return max_batch_size_; }
+
+private:
+    std::vector<int> counts_;
+    int64_t max_batch_size_;
+};
+
+// Handler failing on every event of the first buffer, recording how many of
+// them it was handed before the first event of another buffer.
+class FailingFirstBufferHandler : public IEventHandler<StubEvent>
+{
+public:
+    FailingFirstBufferHandler() : failures_(0), failures_before_others_(-1) {}
+
+    virtual void onEvent(const int64_t& sequence,
+                         const int64_t& batch_size,
+                         const bool& end_of_batch,
+                         StubEvent* event)
+    {
+        if (event->value() == 0) {
+            failures_++;
+            throw std::runtime_error("failing buffer");
+        }
+        if (failures_before_others_ < 0) {
+            failures_before_others_ = failures_;
+        }
+    }
+
+    virtual void onStart() {}
+
+    virtual void onShutdown() {}
+
+    int failures_before_others() const { return failures_before_others_; }
+
+private:
+    int failures_;
+    int failures_before_others_;
+};
+
+// Handler failing on a single event, counting the events of each buffer it
+// handled.
+class FailingEventHandler : public BufferTrackingHandler
+{
+public:
+    FailingEventHandler(int buffer, int64_t sequence)
+        : buffer_(buffer)
+        , sequence_(sequence)
+    {
+    }
+
+    virtual void onEvent(const int64_t& sequence,
+                         const int64_t& batch_size,
+                         const bool& end_of_batch,
+                         StubEvent* event)
+    {
+        if (event->value() == buffer_ && sequence == sequence_) {
+            throw std::runtime_error("failing event");
+        }
+        BufferTrackingHandler::onEvent(sequence, batch_size, end_of_batch,
+                                       event);
+    }
+
+private:
+    const int buffer_;
+    const int64_t sequence_;
+};
+
+// Records the sequence and the buffer of the event each failure is reported
+// against.
+class RecordingExceptionHandler : public IExceptionHandler<StubEvent>
+{
+public:
+    RecordingExceptionHandler() : failures_(0), sequence_(-1), buffer_(-1) {}
+
+    virtual void handle(const std::exception& exception,
+                        const int64_t& sequence,
+                        StubEvent* event)
+    {
+        failures_++;
+        sequence_ = sequence;
+        buffer_ = event ? event->value() : -1;
+    }
+
+    int failures() const { return failures_; }
+
+    int64_t sequence() const { return sequence_; }
+
+    int buffer() const { return buffer_; }
+
+private:
+    int failures_;
+    int64_t sequence_;
+    int buffer_;
+};
+
+typedef MultiBufferBatchEventProcessor<StubEvent> processor_type;
+
+class MultiBufferFixture
+{
+public:
+    explicit MultiBufferFixture(WaitStrategyOption wait_strategy)
+    {
+        for (int i = 0; i < NUM_BUFFERS; i++) {
+            owners_.push_back(boost::shared_ptr<RingBuffer<StubEvent> >(
+                        new RingBuffer<StubEvent>(&factory_, BUFFER_SIZE,
+                            kSingleThreadedStrategy, wait_strategy)));
+            ring_buffers_.push_back(owners_.back().get());
+            barriers_.push_back(
+                    ring_buffers_.back()->newBarrier(DependentSequences()));
+        }
+    }
+
+    void gate(processor_type& processor)
+    {
+        sequences_ = processor.getSequences();
+        for (int i = 0; i < NUM_BUFFERS; i++) {
+            ring_buffers_[i]->setGatingSequences(DependentSequences(1,
+                        sequences_[i]));
+        }
+    }
+
+    void publish(int buffer, int count)
+    {
+        for (int j = 0; j < count; j++) {
+            int64_t sequence = ring_buffers_[buffer]->next();
+            ring_buffers_[buffer]->get(sequence)->set_value(buffer);
+            ring_buffers_[buffer]->publish(sequence);
+        }
+    }
+
+    void waitUntilConsumed(int64_t sequence)
+    {
+        while (getMinimumSequence(sequences_) < sequence) {
+            boost::this_thread::yield();
+        }
+    }
+
+    StubEventFactory factory_;
+    std::vector<boost::shared_ptr<RingBuffer<StubEvent> > > owners_;
+    std::vector<RingBuffer<StubEvent>*> ring_buffers_;
+    std::vector<boost::shared_ptr<ProcessingSequenceBarrier> > barriers_;
+    DependentSequences sequences_;
+};
+
+TEST(MultiBufferBatchEventProcessorTest, testDrainsEveryBufferWithCappedBatches)
+{
+    MultiBufferFixture fixture(kYieldingStrategy);
+    BufferTrackingHandler handler;
+    processor_type processor(fixture.ring_buffers_, fixture.barriers_,
+            &handler, NULL, MAX_BATCH_SIZE);
+    fixture.gate(processor);
+    for (int i = 0; i < NUM_BUFFERS; i++) {
+        fixture.publish(i, BUFFER_SIZE);
+    }
+
+    boost::thread thread(boost::ref<processor_type>(processor));
+    fixture.waitUntilConsumed(BUFFER_SIZE - 1);
+    processor.halt();
+    thread.join();
+
+    for (int i = 0; i < NUM_BUFFERS; i++) {
+        EXPECT_EQ(BUFFER_SIZE, handler.count(i));
+    }
+    EXPECT_EQ(MAX_BATCH_SIZE, handler.max_batch_size());
+}
+
+TEST(MultiBufferBatchEventProcessorTest, testFailingBufferDoesNotStarveOthers)
+{
+    MultiBufferFixture fixture(kYieldingStrategy);
+    FailingFirstBufferHandler handler;
+    processor_type processor(fixture.ring_buffers_, fixture.barriers_,
+            &handler, NULL, MAX_BATCH_SIZE);
+    fixture.gate(processor);
+    for (int i = 0; i < NUM_BUFFERS; i++) {
+        fixture.publish(i, BUFFER_SIZE);
+    }
+
+    boost::thread thread(boost::ref<processor_type>(processor));
+    fixture.waitUntilConsumed(BUFFER_SIZE - 1);
+    processor.halt();
+    thread.join();
+
+    // the round after the failure resumes with the second buffer
+    EXPECT_EQ(1, handler.failures_before_others());
+}
+
+TEST(MultiBufferBatchEventProcessorTest, testFailedEventIsConsumedOnItsBuffer)
+{
+    MultiBufferFixture fixture(kYieldingStrategy);
+    FailingEventHandler handler(1, 3);
+    RecordingExceptionHandler exception_handler;
+    processor_type processor(fixture.ring_buffers_, fixture.barriers_,
+            &handler, &exception_handler, MAX_BATCH_SIZE);
+    fixture.gate(processor);
+
+    boost::thread thread(boost::ref<processor_type>(processor));
+    // twice the capacity, the failing buffer has to release its publisher
+    for (int i = 0; i < NUM_BUFFERS; i++) {
+        fixture.publish(i, 2 * BUFFER_SIZE);
+    }
+    fixture.waitUntilConsumed(2 * BUFFER_SIZE - 1);
+    processor.halt();
+    thread.join();
+
+    EXPECT_EQ(1, exception_handler.failures());
+    EXPECT_EQ(3, exception_handler.sequence());
+    EXPECT_EQ(1, exception_handler.buffer());
+    EXPECT_EQ(2 * BUFFER_SIZE, handler.count(0));
+    EXPECT_EQ(2 * BUFFER_SIZE - 1, handler.count(1));
+    EXPECT_EQ(2 * BUFFER_SIZE, handler.count(2));
+}
+
+TEST(MultiBufferBatchEventProcessorTest, testParkedProcessorHandlesEveryBuffer)
+{
+    MultiBufferFixture fixture(kBlockingStrategy);
+    BufferTrackingHandler handler;
+    processor_type processor(fixture.ring_buffers_, fixture.barriers_,
+            &handler, NULL, MAX_BATCH_SIZE, stdext::chrono::microseconds(100));
+    fixture.gate(processor);
+
+    boost::thread thread(boost::ref<processor_type>(processor));
+    // long enough for the processor to run out of idle yields and park
+    stdext::this_thread::sleep_for(stdext::chrono::milliseconds(20));
+    for (int i = 0; i < NUM_BUFFERS; i++) {
+        fixture.publish(i, BUFFER_SIZE);
+    }
+    fixture.waitUntilConsumed(BUFFER_SIZE - 1);
+    processor.halt();
+    thread.join();
+
+    for (int i = 0; i < NUM_BUFFERS; i++) {
+        EXPECT_EQ(BUFFER_SIZE, handler.count(i));
+    }
+}
+
+TEST(MultiBufferBatchEventProcessorTest, testNoRingBufferThrows)
+{
+    BufferTrackingHandler handler;
+    EXPECT_THROW(processor_type(std::vector<RingBuffer<StubEvent>*>(),
+                std::vector<boost::shared_ptr<ProcessingSequenceBarrier> >(),
+                &handler, NULL, MAX_BATCH_SIZE),
+            std::invalid_argument);
+}
+
+};  // namespace test
+};  // namespace disruptor
@@ -2,10 +2,12 @@
 #include <vector>
 
 #include <boost/shared_ptr.hpp>
+#include <boost/type_traits/is_same.hpp>
 #include <boost/thread.hpp>
 #include <boost/ref.hpp>
 
 #include <disruptor/event_processor.h>
+#include <disruptor/event_publisher.h>
 #include <disruptor/ring_buffer.h>
 
 #include <gtest/gtest.h>
@@ -199,6 +201,190 @@ TEST_F(RingBufferFixture, testGetAtSpecificSequence)
     EXPECT_EQ(ring_buffer.getCursor(), expected_sequence);
 }
 
+#ifdef has_cplusplus11
+TEST_F(RingBufferFixture, testPublishEventWithCallable)
+{
+    EventPublisher<StubEvent> publisher(&ring_buffer);
+
+    publisher.publishEvent(
+            [](const int64_t& sequence, StubEvent* event, int value) {
+                event->set_value(value);
+            },
+            1234);
+    EXPECT_EQ(0, barrier->waitFor(0));
+    EXPECT_EQ(1234, ring_buffer.get(0)->value());
+
+    publisher.publishEvents(
+            [](const int64_t& sequence, StubEvent* event) {
+                event->set_value(static_cast<int>(sequence));
+            },
+            3);
+    EXPECT_EQ(3, barrier->waitFor(1));
+    for (int64_t i = 1; i <= 3; i++) {
+        EXPECT_EQ(i, ring_buffer.get(i)->value());
+    }
+}
+
+TEST_F(RingBufferFixture, testTryPublishEventWithCallableWhenFull)
+{
+    EventPublisher<StubEvent> publisher(&ring_buffer);
+    int published = 0;
+    auto translator = [&published](const int64_t& sequence, StubEvent* event) {
+        event->set_value(++published);
+    };
+
+    EXPECT_TRUE(publisher.tryPublishEvents(translator, BUFFER_SIZE));
+    EXPECT_FALSE(publisher.tryPublishEvent(translator));
+    EXPECT_EQ(BUFFER_SIZE, published);
+}
+#endif
+
+TEST_F(RingBufferFixture, testPublishEventsStreaming)
+{
+    EventPublisher<StubEvent> publisher(&ring_buffer);
+    std::vector<StubEvent> events;
+    for (int i = 0; i < 5; i++) {
+        events.push_back(StubEvent(100 + i));
+    }
+
+    publisher.publishEventsStreaming(&events[0], 5);
+    EXPECT_EQ(4, barrier->waitFor(0));
+    for (int64_t i = 0; i < 5; i++) {
+        EXPECT_EQ(100 + i, ring_buffer.get(i)->value());
+    }
+}
+
+// Event spanning several cache lines, its size not a multiple of 16.
+struct LargeEvent
+{
+    int64_t sequence;
+    char payload[235];
+};
+
+TEST(StreamingCopyTest, testCopiesUnalignedHeadAndTail)
+{
+    char source[300];
+    char destination[300];
+    for (int i = 0; i < 300; i++) {
+        source[i] = static_cast<char>(i);
+    }
+
+    for (int offset = 0; offset < 16; offset++) {
+        memset(destination, 0, sizeof(destination));
+        streamingCopy(destination + offset, source, 250);
+        streamingFence();
+        EXPECT_EQ(0, memcmp(destination + offset, source, 250));
+        EXPECT_EQ(0, destination[offset + 250]);
+    }
+}
+
+TEST(PolicyRingBufferTest, testPublishLargeEventsStreamingAcrossWrap)
+{
+    typedef RingBuffer<LargeEvent, SingleThreadedStrategy, BusySpinStrategy>
+        RingBufferType;
+    RingBufferType ring_buffer(BUFFER_SIZE);
+    Sequence gating_sequence(INITIAL_CURSOR_VALUE);
+    ring_buffer.setGatingSequences(std::vector<Sequence*>(1, &gating_sequence));
+    EventPublisher<LargeEvent, RingBufferType> publisher(&ring_buffer);
+
+    std::vector<LargeEvent> events(BUFFER_SIZE);
+    for (int i = 0; i < BUFFER_SIZE; i++) {
+        events[i].sequence = BUFFER_SIZE / 2 + i;
+        memset(events[i].payload, i, sizeof(events[i].payload));
+    }
+
+    publisher.publishEventsStreaming(&events[0], BUFFER_SIZE / 2);
+    gating_sequence.set(BUFFER_SIZE / 2 - 1);
+    publisher.publishEventsStreaming(&events[0], BUFFER_SIZE);
+
+    EXPECT_EQ(BUFFER_SIZE / 2 * 3 - 1, ring_buffer.getCursor());
+    for (int i = 0; i < BUFFER_SIZE; i++) {
+        LargeEvent* event = ring_buffer.get(BUFFER_SIZE / 2 + i);
+        EXPECT_EQ(BUFFER_SIZE / 2 + i, event->sequence);
+        EXPECT_EQ(0, memcmp(event->payload, events[i].payload,
+                            sizeof(event->payload)));
+    }
+}
+
+TEST(PolicyRingBufferTest, testClaimAndGetWithCompileTimeStrategies)
+{
+    RingBuffer<StubEvent, SingleThreadedStrategy, BusySpinStrategy>
+        ring_buffer(BUFFER_SIZE);
+    Sequence gating_sequence(INITIAL_CURSOR_VALUE);
+    ring_buffer.setGatingSequences(std::vector<Sequence*>(1, &gating_sequence));
+    SequenceBarrierPtr barrier = ring_buffer.newBarrier(std::vector<Sequence*>(0));
+
+    EXPECT_EQ(BUFFER_SIZE, ring_buffer.capacity());
+    EXPECT_EQ(disruptor::INITIAL_CURSOR_VALUE, ring_buffer.getCursor());
+
+    int64_t claim_sequence = ring_buffer.next();
+    ring_buffer.get(claim_sequence)->set_value(1234);
+    ring_buffer.publish(claim_sequence);
+
+    int64_t sequence = barrier->waitFor(0);
+    EXPECT_EQ(0, sequence);
+    EXPECT_EQ(1234, ring_buffer.get(sequence)->value());
+}
+
+TEST(PolicyRingBufferTest, testWrapWithCompileTimeCapacity)
+{
+    FixedRingBuffer<StubEvent, BUFFER_SIZE,
+                    SingleThreadedStrategy, BusySpinStrategy> ring_buffer;
+    Sequence gating_sequence(INITIAL_CURSOR_VALUE);
+    ring_buffer.setGatingSequences(std::vector<Sequence*>(1, &gating_sequence));
+
+    EXPECT_EQ(BUFFER_SIZE, ring_buffer.capacity());
+
+    for (int i = 0; i < BUFFER_SIZE + 1; i++) {
+        int64_t sequence = ring_buffer.next();
+        ring_buffer.get(sequence)->set_value(i);
+        ring_buffer.publish(sequence);
+        gating_sequence.set(sequence);
+    }
+
+    EXPECT_EQ(BUFFER_SIZE, ring_buffer.get(0)->value());
+    EXPECT_EQ(BUFFER_SIZE, ring_buffer.get(BUFFER_SIZE)->value());
+    EXPECT_EQ(1, ring_buffer.get(1)->value());
+}
+
+TEST(PolicyRingBufferTest, testCompileTimeCapacityReachesClaimStrategy)
+{
+    typedef FixedRingBuffer<StubEvent, BUFFER_SIZE,
+                            MultiThreadedStrategy, BusySpinStrategy>
+        RingBufferType;
+    EXPECT_TRUE((boost::is_same<
+                BasicSequencer<BasicMultiThreadedStrategy<BUFFER_SIZE>,
+                               BusySpinStrategy>,
+                RingBufferType::sequencer_type>::value));
+}
+
+TEST(PolicyRingBufferTest, testDefaultPoliciesWithCompileTimeCapacity)
+{
+    StubEventFactory factory;
+    FixedRingBuffer<StubEvent, BUFFER_SIZE> ring_buffer(&factory);
+    Sequence gating_sequence(INITIAL_CURSOR_VALUE);
+    ring_buffer.setGatingSequences(std::vector<Sequence*>(1, &gating_sequence));
+    SequenceBarrierPtr barrier =
+        ring_buffer.newBarrier(std::vector<Sequence*>(0));
+
+    for (int i = 0; i < BUFFER_SIZE + 1; i++) {
+        int64_t sequence = ring_buffer.next();
+        ring_buffer.get(sequence)->set_value(i);
+        ring_buffer.publish(sequence);
+        gating_sequence.set(sequence);
+    }
+
+    EXPECT_EQ(BUFFER_SIZE, barrier->waitFor(BUFFER_SIZE));
+    EXPECT_EQ(BUFFER_SIZE, ring_buffer.get(BUFFER_SIZE)->value());
+    EXPECT_EQ(1, ring_buffer.get(1)->value());
+
+    FixedRingBuffer<StubEvent, BUFFER_SIZE> selected(&factory,
+            kSingleThreadedStrategy, kYieldingStrategy);
+    EXPECT_EQ(BUFFER_SIZE, selected.capacity());
+    selected.publish(selected.next());
+    EXPECT_EQ(0, selected.getCursor());
+}
+
 // Publisher will try to publish BUFFER_SIZE + 1 events. The last event
 // should wait for at least one consume before publishing, thus preventing
 // an overwrite. After the single consume, the publisher should resume and 
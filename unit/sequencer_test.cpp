@@ -1,5 +1,10 @@
 #include <iostream>
 
+#ifdef __linux__
+#include <fcntl.h>
+#include <poll.h>
+#endif
+
 #include <boost/atomic.hpp>
 #include <boost/thread.hpp>
 
@@ -67,6 +72,25 @@ TEST_F(SequencerFixture, testIndicateNoAvailableCapacity)
     EXPECT_FALSE(sequencer.hasAvailableCapacity());
 }
 
+TEST_F(SequencerFixture, testTryNextFailsWhenBufferIsFull)
+{
+    int64_t sequence = INITIAL_CURSOR_VALUE;
+    EXPECT_TRUE(sequencer.tryNext(BUFFER_SIZE - 1, sequence));
+    EXPECT_EQ(INITIAL_CURSOR_VALUE + BUFFER_SIZE - 1, sequence);
+
+    int64_t batch_end = INITIAL_CURSOR_VALUE;
+    EXPECT_FALSE(sequencer.tryNext(2, batch_end));
+    EXPECT_EQ(INITIAL_CURSOR_VALUE, batch_end);
+
+    EXPECT_TRUE(sequencer.tryNext(sequence));
+    EXPECT_EQ(INITIAL_CURSOR_VALUE + BUFFER_SIZE, sequence);
+    EXPECT_FALSE(sequencer.tryNext(sequence));
+
+    gating_sequence.set(INITIAL_CURSOR_VALUE + 1LL);
+    EXPECT_TRUE(sequencer.tryNext(sequence));
+    EXPECT_EQ(INITIAL_CURSOR_VALUE + BUFFER_SIZE + 1LL, sequence);
+}
+
 TEST_F(SequencerFixture, testForceClaimSequence)
 {
     const int64_t claim_sequence = 3;
@@ -111,6 +135,26 @@ TEST_F(SequencerFixture, testPublishSequenceBatch)
     EXPECT_EQ(INITIAL_CURSOR_VALUE + batch_size, sequencer.getCursor());
 }
 
+TEST_F(SequencerFixture, testPublishSequenceRange)
+{
+    const int batch_size = 3;
+    const int64_t hi = sequencer.next(batch_size);
+    const int64_t lo = hi - batch_size + 1;
+
+    EXPECT_EQ(INITIAL_CURSOR_VALUE, sequencer.getCursor());
+    EXPECT_EQ(INITIAL_CURSOR_VALUE + 1LL, lo);
+    EXPECT_EQ(INITIAL_CURSOR_VALUE + batch_size, hi);
+
+    sequencer.publish(lo, hi);
+    EXPECT_EQ(hi, sequencer.getCursor());
+}
+
+TEST_F(SequencerFixture, testRejectBatchLargerThanCapacity)
+{
+    EXPECT_THROW(sequencer.next(BUFFER_SIZE + 1), std::invalid_argument);
+    EXPECT_THROW(sequencer.next(0), std::invalid_argument);
+}
+
 TEST_F(SequencerFixture, testWaitOnSequence)
 {
     std::vector<Sequence*> dependents(0);
@@ -136,6 +180,29 @@ TEST_F(SequencerFixture, testWaitOnSequenceShowingBatchingEffect)
     EXPECT_EQ(barrier->waitFor(INITIAL_CURSOR_VALUE + 1LL), sequence);
 }
 
+TEST_F(SequencerFixture, testOnlyExposeContiguousPublishedSequences)
+{
+    Sequencer multi_sequencer(BUFFER_SIZE,
+                              kMultiThreadedAvailabilityStrategy,
+                              kSleepingStrategy);
+    multi_sequencer.setGatingSequences(
+            std::vector<Sequence*>(1, &gating_sequence));
+
+    std::vector<Sequence*> dependents(0);
+    SequenceBarrierPtr barrier = multi_sequencer.newBarrier(dependents);
+
+    const int64_t first = multi_sequencer.next();
+    const int64_t second = multi_sequencer.next();
+    multi_sequencer.publish(second);
+
+    EXPECT_EQ(second, multi_sequencer.getCursor());
+    EXPECT_EQ(INITIAL_CURSOR_VALUE, barrier->waitFor(first));
+
+    multi_sequencer.publish(first);
+    EXPECT_EQ(second, multi_sequencer.getCursor());
+    EXPECT_EQ(second, barrier->waitFor(first));
+}
+
 class SignalWaitingProcessorPublisher
 {
     private:
@@ -190,6 +257,276 @@ TEST_F(SequencerFixture, testSignalWaitingProcessorWhenSequenceIsPublished)
     thread.join();
 }
 
+class ParkingSequencerTest : public ::testing::TestWithParam<WaitStrategyOption>
+{
+};
+
+TEST_P(ParkingSequencerTest, testSignalParkedProcessorWhenSequenceIsPublished)
+{
+    Sequencer sequencer(BUFFER_SIZE, kSingleThreadedStrategy, GetParam());
+    Sequence gating_sequence(INITIAL_CURSOR_VALUE);
+    sequencer.setGatingSequences(std::vector<Sequence*>(1, &gating_sequence));
+    SequenceBarrierPtr barrier = sequencer.newBarrier(std::vector<Sequence*>(0));
+
+    boost::atomic<bool> waiting(true);
+    boost::atomic<bool> completed(false);
+
+    SignalWaitingProcessorPublisher publisher(&gating_sequence, barrier.get(), &waiting, &completed);
+    boost::thread thread(boost::ref(publisher));
+
+    while (waiting.load()) {}
+    // give the processor time to park on the condition
+    boost::this_thread::sleep_for(boost::chrono::milliseconds(10));
+
+    sequencer.publish(sequencer.next());
+
+    thread.join();
+    EXPECT_TRUE(completed.load());
+    EXPECT_EQ(INITIAL_CURSOR_VALUE + 1LL, gating_sequence.get());
+}
+
+#ifdef __linux__
+INSTANTIATE_TEST_CASE_P(ParkingStrategies, ParkingSequencerTest,
+                        ::testing::Values(kLiteBlockingStrategy,
+                                          kPhasedBackoffBlockingStrategy,
+                                          kPhasedBackoffLiteBlockingStrategy,
+                                          kAdaptiveStrategy,
+                                          kFutexStrategy,
+                                          kEventFdStrategy));
+#else
+INSTANTIATE_TEST_CASE_P(ParkingStrategies, ParkingSequencerTest,
+                        ::testing::Values(kLiteBlockingStrategy,
+                                          kPhasedBackoffBlockingStrategy,
+                                          kPhasedBackoffLiteBlockingStrategy,
+                                          kAdaptiveStrategy));
+#endif
+
+// the spinning strategies never park, the processor sees the publication
+// from its spin loop
+INSTANTIATE_TEST_CASE_P(SpinningStrategies, ParkingSequencerTest,
+                        ::testing::Values(kBusySpinStrategy,
+                                          kPausingBusySpinStrategy));
+
+TEST(BarrierWaitStrategyTest, testSignalParkedProcessorOfBarrierStrategy)
+{
+    Sequencer sequencer(BUFFER_SIZE, kSingleThreadedStrategy,
+                        kBusySpinStrategy);
+    Sequence spinning_sequence(INITIAL_CURSOR_VALUE);
+    Sequence parking_sequence(INITIAL_CURSOR_VALUE);
+    std::vector<Sequence*> gating_sequences;
+    gating_sequences.push_back(&spinning_sequence);
+    gating_sequences.push_back(&parking_sequence);
+    sequencer.setGatingSequences(gating_sequences);
+    SequenceBarrierPtr spinning_barrier =
+        sequencer.newBarrier(std::vector<Sequence*>(0));
+    SequenceBarrierPtr parking_barrier = sequencer.newBarrier(
+            std::vector<Sequence*>(0), kLiteBlockingStrategy);
+
+    boost::atomic<bool> spinning_waiting(true);
+    boost::atomic<bool> spinning_completed(false);
+    boost::atomic<bool> parking_waiting(true);
+    boost::atomic<bool> parking_completed(false);
+    SignalWaitingProcessorPublisher spinning(&spinning_sequence,
+            spinning_barrier.get(), &spinning_waiting, &spinning_completed);
+    SignalWaitingProcessorPublisher parking(&parking_sequence,
+            parking_barrier.get(), &parking_waiting, &parking_completed);
+    boost::thread spinning_thread(boost::ref(spinning));
+    boost::thread parking_thread(boost::ref(parking));
+
+    while (spinning_waiting.load() || parking_waiting.load()) {}
+    // give the processor time to park on the condition
+    boost::this_thread::sleep_for(boost::chrono::milliseconds(10));
+
+    sequencer.publish(sequencer.next());
+
+    spinning_thread.join();
+    parking_thread.join();
+    EXPECT_TRUE(spinning_completed.load());
+    EXPECT_TRUE(parking_completed.load());
+    EXPECT_EQ(INITIAL_CURSOR_VALUE + 1LL, parking_sequence.get());
+}
+
+TEST(BarrierWaitStrategyTest, testUnregisterStrategyOfDestroyedBarrier)
+{
+    Sequencer sequencer(BUFFER_SIZE, kSingleThreadedStrategy,
+                        kBusySpinStrategy);
+    boost::shared_ptr<RuntimeWaitStrategy> strategy =
+        boost::make_shared<RuntimeWaitStrategy>(kLiteBlockingStrategy,
+                                                TimeConfig());
+    SequenceBarrierPtr first = sequencer.newBarrier(
+            std::vector<Sequence*>(0), strategy);
+    SequenceBarrierPtr second = sequencer.newBarrier(
+            std::vector<Sequence*>(0), strategy);
+    sequencer.reclaim();
+    // held by the test, the two barriers and the list of the publishers
+    EXPECT_EQ(5, strategy.use_count());
+
+    first.reset();
+    sequencer.reclaim();
+    EXPECT_EQ(3, strategy.use_count());
+
+    second.reset();
+    sequencer.publish(sequencer.next());
+    sequencer.reclaim();
+    EXPECT_EQ(1, strategy.use_count());
+}
+
+TEST(AdaptiveStrategyTest, testBackoffFollowsLatencyBudget)
+{
+    // parking wakes up well within a second, no need to spin.
+    AdaptiveStrategy relaxed(boost::chrono::seconds(1));
+    EXPECT_EQ(0, relaxed.getBackoffTime().count());
+    EXPECT_EQ(0, relaxed.getSpinTime().count());
+
+    AdaptiveStrategy strict(boost::chrono::microseconds(1));
+    EXPECT_LT(0, strict.getBackoffTime().count());
+    EXPECT_LE(strict.getSpinTime(), strict.getBackoffTime());
+    EXPECT_EQ(kRunningPhase, strict.getPhase());
+}
+
+TEST(AdaptiveStrategyTest, testReportParkedPhase)
+{
+    BasicSequencer<SingleThreadedStrategy, AdaptiveStrategy> sequencer(
+            BUFFER_SIZE);
+    Sequence gating_sequence(INITIAL_CURSOR_VALUE);
+    sequencer.setGatingSequences(std::vector<Sequence*>(1, &gating_sequence));
+    AdaptiveStrategy& strategy = sequencer.getWaitStrategy();
+
+    SequenceBarrierPtr barrier = sequencer.newBarrier(
+            std::vector<Sequence*>(0));
+    boost::atomic<bool> waiting(true);
+    boost::atomic<bool> completed(false);
+    SignalWaitingProcessorPublisher publisher(&gating_sequence,
+            barrier.get(), &waiting, &completed);
+    boost::thread thread(boost::ref(publisher));
+
+    while (strategy.getPhase() != kParkedPhase) {
+        boost::this_thread::yield();
+    }
+    sequencer.publish(sequencer.next());
+
+    thread.join();
+    EXPECT_TRUE(completed.load());
+    EXPECT_EQ(kRunningPhase, strategy.getPhase());
+    EXPECT_LT(0, strategy.getAverageGap().count());
+}
+
+#ifdef __linux__
+bool isReadable(int fd)
+{
+    struct pollfd poll_fd;
+    poll_fd.fd = fd;
+    poll_fd.events = POLLIN;
+    return poll(&poll_fd, 1, 0) == 1;
+}
+
+TEST(EventFdSequencerTest, testSignalEventFdOnlyWhenIdle)
+{
+    BasicSequencer<SingleThreadedStrategy, EventFdStrategy> sequencer(
+            BUFFER_SIZE);
+    Sequence gating_sequence(INITIAL_CURSOR_VALUE);
+    sequencer.setGatingSequences(std::vector<Sequence*>(1, &gating_sequence));
+    SequenceBarrierPtr barrier = sequencer.newBarrier(std::vector<Sequence*>(0));
+    EventFdStrategy& strategy = sequencer.getWaitStrategy();
+
+    sequencer.publish(sequencer.next());
+    EXPECT_FALSE(isReadable(strategy.getFd(*barrier)));
+
+    strategy.markIdle(*barrier);
+    sequencer.publish(sequencer.next());
+    sequencer.publish(sequencer.next());
+    EXPECT_TRUE(isReadable(strategy.getFd(*barrier)));
+
+    strategy.markBusy(*barrier);
+    EXPECT_FALSE(isReadable(strategy.getFd(*barrier)));
+    sequencer.publish(sequencer.next());
+    EXPECT_FALSE(isReadable(strategy.getFd(*barrier)));
+}
+
+TEST(EventFdSequencerTest, testBusyConsumerKeepsWakeUpOfIdleConsumer)
+{
+    BasicSequencer<SingleThreadedStrategy, EventFdStrategy> sequencer(
+            BUFFER_SIZE);
+    Sequence gating_sequence(INITIAL_CURSOR_VALUE);
+    sequencer.setGatingSequences(std::vector<Sequence*>(1, &gating_sequence));
+    SequenceBarrierPtr first = sequencer.newBarrier(std::vector<Sequence*>(0));
+    SequenceBarrierPtr second = sequencer.newBarrier(std::vector<Sequence*>(0));
+    EventFdStrategy& strategy = sequencer.getWaitStrategy();
+    EXPECT_NE(strategy.getFd(*first), strategy.getFd(*second));
+
+    strategy.markIdle(*first);
+    strategy.markIdle(*second);
+    sequencer.publish(sequencer.next());
+    strategy.markBusy(*first);
+
+    EXPECT_FALSE(isReadable(strategy.getFd(*first)));
+    EXPECT_TRUE(isReadable(strategy.getFd(*second)));
+    strategy.markBusy(*second);
+}
+
+TEST(EventFdSequencerTest, testDestroyedBarrierReleasesItsEventFd)
+{
+    BasicSequencer<SingleThreadedStrategy, EventFdStrategy> sequencer(
+            BUFFER_SIZE);
+    EventFdStrategy& strategy = sequencer.getWaitStrategy();
+    std::vector<SequenceBarrierPtr> barriers;
+    for (int i = 0; i < EventFdStrategy::kMaxWaiters; i++) {
+        barriers.push_back(sequencer.newBarrier(std::vector<Sequence*>(0)));
+    }
+    EXPECT_THROW(sequencer.newBarrier(std::vector<Sequence*>(0)),
+                 std::length_error);
+
+    int fd = strategy.getFd(*barriers.back());
+    barriers.pop_back();
+    EXPECT_EQ(-1, fcntl(fd, F_GETFD));
+
+    // the released slot is taken by a new barrier, with its own eventfd
+    barriers.push_back(sequencer.newBarrier(std::vector<Sequence*>(0)));
+    strategy.markIdle(*barriers.back());
+    sequencer.publish(sequencer.next());
+    EXPECT_TRUE(isReadable(strategy.getFd(*barriers.back())));
+    strategy.markBusy(*barriers.back());
+}
+
+TEST(EventFdSequencerTest, testSignalTwoParkedProcessors)
+{
+    Sequencer sequencer(BUFFER_SIZE, kSingleThreadedStrategy,
+                        kEventFdStrategy);
+    Sequence first_sequence(INITIAL_CURSOR_VALUE);
+    Sequence second_sequence(INITIAL_CURSOR_VALUE);
+    std::vector<Sequence*> gating_sequences;
+    gating_sequences.push_back(&first_sequence);
+    gating_sequences.push_back(&second_sequence);
+    sequencer.setGatingSequences(gating_sequences);
+    SequenceBarrierPtr first_barrier =
+        sequencer.newBarrier(std::vector<Sequence*>(0));
+    SequenceBarrierPtr second_barrier =
+        sequencer.newBarrier(std::vector<Sequence*>(0));
+
+    boost::atomic<bool> first_waiting(true);
+    boost::atomic<bool> first_completed(false);
+    boost::atomic<bool> second_waiting(true);
+    boost::atomic<bool> second_completed(false);
+    SignalWaitingProcessorPublisher first(&first_sequence,
+            first_barrier.get(), &first_waiting, &first_completed);
+    SignalWaitingProcessorPublisher second(&second_sequence,
+            second_barrier.get(), &second_waiting, &second_completed);
+    boost::thread first_thread(boost::ref(first));
+    boost::thread second_thread(boost::ref(second));
+
+    while (first_waiting.load() || second_waiting.load()) {}
+    // give the processors time to park on their eventfds
+    boost::this_thread::sleep_for(boost::chrono::milliseconds(10));
+
+    sequencer.publish(sequencer.next());
+
+    first_thread.join();
+    second_thread.join();
+    EXPECT_TRUE(first_completed.load());
+    EXPECT_TRUE(second_completed.load());
+}
+#endif
+
 class HoldUpPublisher
 {
     private:
@@ -243,6 +580,232 @@ TEST_F(SequencerFixture, testHoldUpPublisherWhenRingIsFull)
 
 }
 
+class ProducerWaitSequencerTest
+    : public ::testing::TestWithParam<ProducerWaitStrategyOption>
+{
+};
+
+TEST_P(ProducerWaitSequencerTest, testReleaseStalledPublisherWhenSlotIsFreed)
+{
+    Sequencer sequencer(BUFFER_SIZE, kMultiThreadedStrategy,
+                        kSleepingStrategy, GetParam());
+    Sequence gating_sequence(INITIAL_CURSOR_VALUE);
+    sequencer.setGatingSequences(std::vector<Sequence*>(1, &gating_sequence));
+    stdext::shared_ptr<Sequencer::barrier_type> barrier =
+        sequencer.newBarrier(std::vector<Sequence*>(0));
+    for (int i = 0; i < BUFFER_SIZE; i++) {
+        sequencer.publish(sequencer.next());
+    }
+    EXPECT_EQ(0, sequencer.getProducerStallCount());
+
+    boost::atomic<bool> waiting(true);
+    boost::atomic<bool> completed(false);
+    HoldUpPublisher publisher(&sequencer, &waiting, &completed);
+    boost::thread thread(boost::ref(publisher));
+
+    while (waiting.load()) {}
+    // give the publisher time to park
+    boost::this_thread::sleep_for(boost::chrono::milliseconds(10));
+    EXPECT_FALSE(completed.load());
+
+    gating_sequence.set(INITIAL_CURSOR_VALUE + 1LL);
+    barrier->signalProducers();
+
+    thread.join();
+    EXPECT_TRUE(completed.load());
+    EXPECT_EQ(INITIAL_CURSOR_VALUE + BUFFER_SIZE + 1LL, sequencer.getCursor());
+    EXPECT_EQ(1, sequencer.getProducerStallCount());
+}
+
+// Publisher of one sequence through the serialisation of a claim strategy.
+class SerialisingPublisher
+{
+    private:
+        MultiThreadedStrategy* strategy_;
+        Sequence* cursor_;
+        int64_t sequence_;
+        boost::atomic<bool>* waiting_;
+        boost::atomic<bool>* completed_;
+
+    public:
+        SerialisingPublisher(
+            MultiThreadedStrategy* strategy,
+            Sequence* cursor,
+            int64_t sequence,
+            boost::atomic<bool>* waiting,
+            boost::atomic<bool>* completed)
+            : strategy_(strategy)
+            , cursor_(cursor)
+            , sequence_(sequence)
+            , waiting_(waiting)
+            , completed_(completed)
+        {
+        }
+
+        void operator() ()
+        {
+            waiting_->store(false);
+            strategy_->serialisePublishing(sequence_, *cursor_, 1);
+            completed_->store(true);
+        }
+};
+
+TEST_P(ProducerWaitSequencerTest, testReleasePublisherHeldUpByPendingPublications)
+{
+    const int pending_size = 4;
+    MultiThreadedStrategy strategy(BUFFER_SIZE * 4, pending_size,
+            createProducerWaitStrategy(GetParam(), TimeConfig()));
+    Sequence cursor(INITIAL_CURSOR_VALUE);
+    // sequence 0 is held up, 1 to 3 are left pending behind it
+    for (int64_t sequence = 1; sequence < pending_size; sequence++) {
+        strategy.serialisePublishing(sequence, cursor, 1);
+    }
+    EXPECT_EQ(INITIAL_CURSOR_VALUE, cursor.get());
+
+    boost::atomic<bool> waiting(true);
+    boost::atomic<bool> completed(false);
+    SerialisingPublisher publisher(&strategy, &cursor, pending_size,
+                                   &waiting, &completed);
+    boost::thread thread(boost::ref(publisher));
+
+    while (waiting.load()) {}
+    // give the publisher time to park
+    boost::this_thread::sleep_for(boost::chrono::milliseconds(10));
+    EXPECT_FALSE(completed.load());
+
+    strategy.serialisePublishing(0, cursor, 1);
+
+    thread.join();
+    EXPECT_TRUE(completed.load());
+    EXPECT_EQ(pending_size, cursor.get());
+    EXPECT_EQ(1, strategy.getStallCount());
+}
+
+#ifdef __linux__
+INSTANTIATE_TEST_CASE_P(ProducerWaitStrategies, ProducerWaitSequencerTest,
+                        ::testing::Values(kBusySpinProducerWaitStrategy,
+                                          kPausingProducerWaitStrategy,
+                                          kYieldingProducerWaitStrategy,
+                                          kSleepingProducerWaitStrategy,
+                                          kFutexProducerWaitStrategy));
+#else
+INSTANTIATE_TEST_CASE_P(ProducerWaitStrategies, ProducerWaitSequencerTest,
+                        ::testing::Values(kBusySpinProducerWaitStrategy,
+                                          kPausingProducerWaitStrategy,
+                                          kYieldingProducerWaitStrategy,
+                                          kSleepingProducerWaitStrategy));
+#endif
+
+TEST(ProducerWaitSequencerTest, testMultiThreadedStrategyWithDefaults)
+{
+    Sequence gating_sequence(INITIAL_CURSOR_VALUE);
+    MultiThreadedStrategy strategy(BUFFER_SIZE);
+    AtomicGatingSequences gating_sequences(
+            DependentSequences(1, &gating_sequence));
+    EXPECT_TRUE(strategy.hasAvailableCapacity(gating_sequences));
+
+    BasicSequencer<MultiThreadedStrategy, BusySpinStrategy> sequencer(
+            BUFFER_SIZE);
+    sequencer.setGatingSequences(DependentSequences(1, &gating_sequence));
+    for (int i = 0; i < BUFFER_SIZE; i++) {
+        sequencer.publish(sequencer.next());
+    }
+    EXPECT_EQ(INITIAL_CURSOR_VALUE + BUFFER_SIZE, sequencer.getCursor());
+    EXPECT_FALSE(sequencer.hasAvailableCapacity());
+}
+
+TEST_F(SequencerFixture, testAddAndRemoveGatingSequences)
+{
+    fillBuffer();
+    Sequence tap(INITIAL_CURSOR_VALUE);
+
+    sequencer.addGatingSequences(DependentSequences(1, &tap));
+    EXPECT_EQ(sequencer.getCursor(), tap.get());
+    EXPECT_FALSE(sequencer.hasAvailableCapacity());
+
+    EXPECT_TRUE(sequencer.removeGatingSequences(
+                DependentSequences(1, &gating_sequence)));
+    EXPECT_FALSE(sequencer.removeGatingSequences(
+                DependentSequences(1, &gating_sequence)));
+    EXPECT_TRUE(sequencer.hasAvailableCapacity());
+    EXPECT_EQ(0, sequencer.occupiedCapacity());
+}
+
+class CountingPublisher
+{
+    private:
+        Sequencer* sequencer_;
+        int64_t count_;
+
+    public:
+        CountingPublisher(Sequencer* sequencer, int64_t count)
+            : sequencer_(sequencer)
+            , count_(count)
+        {
+        }
+
+        void operator() ()
+        {
+            for (int64_t i = 0; i < count_; ++i) {
+                sequencer_->publish(sequencer_->next());
+            }
+        }
+};
+
+class FollowingConsumer
+{
+    private:
+        Sequencer* sequencer_;
+        Sequence* sequence_;
+        int64_t last_;
+
+    public:
+        FollowingConsumer(Sequencer* sequencer, Sequence* sequence,
+                          int64_t last)
+            : sequencer_(sequencer)
+            , sequence_(sequence)
+            , last_(last)
+        {
+        }
+
+        void operator() ()
+        {
+            while (sequence_->get() < last_) {
+                sequence_->set(sequencer_->getCursor());
+                boost::this_thread::yield();
+            }
+        }
+};
+
+TEST(GatingSequencesSequencerTest, testAddAndRemoveGatingSequencesInALoop)
+{
+    const int64_t events = 100000;
+    Sequencer sequencer(BUFFER_SIZE, kSingleThreadedStrategy,
+                        kYieldingStrategy);
+    Sequence consumer_sequence(INITIAL_CURSOR_VALUE);
+    sequencer.setGatingSequences(DependentSequences(1, &consumer_sequence));
+
+    CountingPublisher publisher(&sequencer, events);
+    FollowingConsumer consumer(&sequencer, &consumer_sequence, events - 1);
+    boost::thread publisher_thread(boost::ref(publisher));
+    boost::thread consumer_thread(boost::ref(consumer));
+
+    // the replaced snapshots are retired while the publisher may still be
+    // reading them
+    for (int i = 0; i < 10000; ++i) {
+        Sequence tap(INITIAL_CURSOR_VALUE);
+        sequencer.addGatingSequences(DependentSequences(1, &tap));
+        EXPECT_TRUE(sequencer.removeGatingSequences(
+                    DependentSequences(1, &tap)));
+    }
+
+    publisher_thread.join();
+    consumer_thread.join();
+    sequencer.reclaim();
+    EXPECT_EQ(events - 1, sequencer.getCursor());
+    EXPECT_TRUE(sequencer.hasAvailableCapacity());
+}
+
 
 }; // namepspace test
 }; // namepspace disruptor
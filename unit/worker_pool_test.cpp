@@ -0,0 +1,154 @@
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+
+#include <disruptor/ring_buffer.h>
+#include <disruptor/worker_pool.h>
+
+#include <gtest/gtest.h>
+
+#include "utils.h"
+
+#define BUFFER_SIZE 64
+#define NUM_WORKERS 3
+#define NUM_EVENTS 10000
+
+namespace disruptor {
+namespace test {
+
+class CountingWorkHandler : public IWorkHandler<StubEvent>
+{
+public:
+    virtual void onEvent(const int64_t& sequence, StubEvent* event)
+    {
+        values_.push_back(event->value());
+    }
+
+    virtual void onStart() {}
+
+    virtual void onShutdown() {}
+
+    const std::vector<int>& values() const { return values_; }
+
+private:
+    std::vector<int> values_;
+};
+
+class WorkerPoolFixture : public ::testing::TestWithParam<int>
+{
+protected:
+    WorkerPoolFixture()
+        : factory(new StubEventFactory())
+        , ring_buffer(factory.get(),
+                    BUFFER_SIZE,
+                    kMultiThreadedLowContentionStrategy,
+                    kYieldingStrategy)
+    {
+        for (int i = 0; i < NUM_WORKERS; i++) {
+            handlers.push_back(boost::shared_ptr<CountingWorkHandler>(
+                        new CountingWorkHandler()));
+        }
+    }
+
+    void publish(int n)
+    {
+        for (int i = 0; i < n; i++) {
+            int64_t sequence = ring_buffer.next();
+            ring_buffer.get(sequence)->set_value(i);
+            ring_buffer.publish(sequence);
+        }
+    }
+
+    boost::shared_ptr<StubEventFactory> factory;
+    RingBuffer<StubEvent> ring_buffer;
+    std::vector<boost::shared_ptr<CountingWorkHandler> > handlers;
+};
+
+TEST_P(WorkerPoolFixture, testEachEventIsHandledByExactlyOneWorker)
+{
+    std::vector<IWorkHandler<StubEvent>*> work_handlers;
+    for (size_t i = 0; i < handlers.size(); i++) {
+        work_handlers.push_back(handlers[i].get());
+    }
+
+    WorkerPool<StubEvent> pool(&ring_buffer,
+            ring_buffer.newBarrier(DependentSequences()),
+            work_handlers,
+            NULL,
+            stdext::chrono::microseconds(1000),
+            GetParam());
+    ring_buffer.setGatingSequences(pool.getWorkerSequences());
+
+    pool.start();
+    publish(NUM_EVENTS);
+    pool.drainAndHalt();
+
+    std::vector<int> seen(NUM_EVENTS, 0);
+    int total = 0;
+    for (size_t i = 0; i < handlers.size(); i++) {
+        const std::vector<int>& values = handlers[i]->values();
+        for (size_t j = 0; j < values.size(); j++) {
+            seen[values[j]]++;
+        }
+        total += values.size();
+    }
+    EXPECT_EQ(NUM_EVENTS, total);
+
+    for (int i = 0; i < NUM_EVENTS; i++) {
+        EXPECT_EQ(1, seen[i]) << "event " << i;
+    }
+}
+
+TEST_P(WorkerPoolFixture, testRestartAfterHalt)
+{
+    std::vector<IWorkHandler<StubEvent>*> work_handlers;
+    for (size_t i = 0; i < handlers.size(); i++) {
+        work_handlers.push_back(handlers[i].get());
+    }
+
+    WorkerPool<StubEvent> pool(&ring_buffer,
+            ring_buffer.newBarrier(DependentSequences()),
+            work_handlers,
+            NULL,
+            stdext::chrono::microseconds(1000),
+            GetParam());
+    ring_buffer.setGatingSequences(pool.getWorkerSequences());
+
+    pool.start();
+    pool.halt();
+    EXPECT_FALSE(pool.isRunning());
+
+    pool.start();
+    publish(NUM_EVENTS);
+    pool.drainAndHalt();
+
+    int total = 0;
+    for (size_t i = 0; i < handlers.size(); i++) {
+        total += handlers[i]->values().size();
+    }
+    EXPECT_EQ(NUM_EVENTS, total);
+}
+
+INSTANTIATE_TEST_CASE_P(ClaimBatchSizes, WorkerPoolFixture,
+                        ::testing::Values(1, 4, BUFFER_SIZE));
+
+TEST(WorkerPoolTest, testRejectClaimBatchLargerThanCapacity)
+{
+    StubEventFactory factory;
+    RingBuffer<StubEvent> ring_buffer(&factory, BUFFER_SIZE,
+                                      kSingleThreadedStrategy,
+                                      kYieldingStrategy);
+    CountingWorkHandler handler;
+    std::vector<IWorkHandler<StubEvent>*> work_handlers(1, &handler);
+
+    EXPECT_THROW(WorkerPool<StubEvent>(&ring_buffer,
+                    ring_buffer.newBarrier(DependentSequences()),
+                    work_handlers,
+                    NULL,
+                    stdext::chrono::microseconds(1000),
+                    BUFFER_SIZE + 1),
+                 std::invalid_argument);
+}
+
+};  // namespace test
+};  // namespace disruptor